@@ -0,0 +1,5489 @@
+#pragma once
+
+#include <condition_variable>
+#include <coroutine>
+#include <functional>
+#include <algorithm>
+#include <unordered_map>
+#include <memory_resource>
+#include <optional>
+#include <concepts>
+#include <cstdint>
+#include <cstddef>
+#include <utility>
+#include <limits>
+#include <memory>
+#include <vector>
+#include <ranges>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <deque>
+#include <array>
+#include <map>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <span>
+#include <numeric>
+#include <bit>
+#include <chrono>
+#include <string_view>
+#include <iterator>
+#include <exception>
+
+#include <cstdio>
+#include <cstring>
+#include <cmath>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+// Per-system profiling is compiled out unless ECS_PROFILING is defined to 1
+#if !defined(ECS_PROFILING)
+#define ECS_PROFILING 0
+#endif
+
+#if defined(__unix__) || defined(__APPLE__)
+#define ECS_HAS_MMAP 1
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#else
+#define ECS_HAS_MMAP 0
+#endif
+
+// Represents an entity in the ECS system, the low bits of its ID are an index and the high bits a generation
+// The generation has 8 bits and wraps after 256 recycles of an index, so an ID kept that long past its destruction is valid again
+struct Entity
+{
+    using IDType = std::uint32_t; // Entity ID type
+    static constexpr unsigned IndexBits = 24; // Number of ID bits holding the index
+    static constexpr IDType IndexMask = (IDType{ 1 } << IndexBits) - 1;
+    static constexpr IDType GenerationMask = std::numeric_limits<IDType>::max() >> IndexBits;
+    static constexpr IDType Invalid = std::numeric_limits<IDType>::max(); // Returned when no index is left, never alive
+
+    IDType id{};
+
+    // Build an entity ID from an index and a generation
+    [[nodiscard]] static constexpr IDType makeID(IDType index, IDType generation) noexcept
+    {
+        return (index & IndexMask) | ((generation & GenerationMask) << IndexBits);
+    }
+
+    // Get the index part of an entity ID, used to address sparse pages and lookup tables
+    [[nodiscard]] static constexpr IDType indexOf(IDType entityID) noexcept { return entityID & IndexMask; }
+
+    // Get the generation part of an entity ID, bumped every time the index is recycled
+    [[nodiscard]] static constexpr IDType generationOf(IDType entityID) noexcept { return entityID >> IndexBits; }
+};
+
+// Concept to ensure a type is a valid component
+template<class T>
+concept ComponentConcept = std::movable<T> && std::default_initializable<T>;
+
+// Opt-in reflection of a simple aggregate for structure-of-arrays storage, specializations define a tuple of member pointers
+template<class Component>
+struct SoALayout;
+
+// Concept to ensure a component opted into structure-of-arrays storage
+template<class T>
+concept SoAComponentConcept = ComponentConcept<T> && requires { SoALayout<T>::members; };
+
+// Concept to ensure a component is a tag, an empty type stored without any payload
+template<class T>
+concept TagComponentConcept = ComponentConcept<T> && std::is_empty_v<T> && !SoAComponentConcept<T>;
+
+// Helper to check if a system is callable with a tuple of component types and arguments
+template<class System, class ComponentTuple, class... Args>
+struct IsMultiComponentSystem : std::false_type {};
+
+template<class System, class... Components, class... Args> requires (ComponentConcept<std::remove_const_t<Components>> && ...)
+struct IsMultiComponentSystem<System, std::tuple<Components...>, Args...>
+    : std::bool_constant<sizeof...(Components) != 0 && std::is_nothrow_invocable_v<System&, Components&..., Args...>> {};
+
+// Concept to ensure a type is a valid system over several component types, const component types are only read
+template<class System, class... Args>
+concept MultiSystemConcept =
+    requires
+    {
+        typename System::ComponentTypes; // System must define a tuple of ComponentTypes
+    } && std::default_initializable<System> && IsMultiComponentSystem<System, typename System::ComponentTypes, Args...>::value;
+
+// Runtime identifier of a component type
+using ComponentTypeID = std::uint32_t;
+
+// Generate the next free component type ID
+[[nodiscard]] inline ComponentTypeID nextComponentTypeID() noexcept
+{
+    static std::atomic<ComponentTypeID> counter{};
+    return counter.fetch_add(1, std::memory_order_relaxed);
+}
+
+// Runtime ID of a component type, assigned during dynamic initialization so reading it needs no guard check
+// Inline variables of different types initialize in no specified order, so the values differ between builds and must never be persisted
+// or compared across processes, and reading one from another static initializer may see it before it is assigned
+template<class Component>
+inline const ComponentTypeID ComponentTypeIDOf = nextComponentTypeID();
+
+// Get the runtime ID of a component type, stable for the lifetime of the process but not across builds or runs
+template<class Component>
+[[nodiscard]] ComponentTypeID componentTypeID() noexcept
+{
+    return ComponentTypeIDOf<Component>;
+}
+
+// Type-erased description of a component type, used by storages that handle components without knowing their type
+struct ComponentInfo final
+{
+    ComponentTypeID id{};
+    std::size_t size{};
+    std::size_t alignment{};
+    void (*moveConstruct)(void* destination, void* source) noexcept {}; // Move construct into uninitialized memory
+    void (*destroy)(void* component) noexcept {};
+
+    // Describe a component type only known at runtime, for example one defined by a script, it gets a fresh type ID
+    // Returns nullopt if the alignment is not a power of two or a function is missing, pools call both unconditionally
+    [[nodiscard]] static std::optional<ComponentInfo> runtime(std::size_t size, std::size_t alignment, void (*moveConstruct)(void*, void*) noexcept, void (*destroy)(void*) noexcept) noexcept
+    {
+        if (!std::has_single_bit(alignment) || moveConstruct == nullptr || destroy == nullptr)
+            return std::optional<ComponentInfo>{ std::nullopt };
+        return std::optional<ComponentInfo>{ ComponentInfo{ nextComponentTypeID(), size, alignment, moveConstruct, destroy } };
+    }
+
+    // Describe a component type
+    template<ComponentConcept Component>
+    [[nodiscard]] static ComponentInfo of() noexcept
+    {
+        return ComponentInfo
+        {
+            componentTypeID<Component>(),
+            sizeof(Component),
+            alignof(Component),
+            [](void* destination, void* source) noexcept { ::new (destination) Component(std::move(*static_cast<Component*>(source))); },
+            [](void* component) noexcept { static_cast<Component*>(component)->~Component(); }
+        };
+    }
+};
+
+// Component types a system reads and writes, used to find systems that can run concurrently
+struct SystemAccess final
+{
+    std::vector<ComponentTypeID> reads{};
+    std::vector<ComponentTypeID> writes{};
+
+    // Check if two systems touch a common component type and at least one of them writes it
+    [[nodiscard]] bool conflictsWith(const SystemAccess& other) const noexcept
+    {
+        const auto touches = [](const SystemAccess& access, ComponentTypeID id) noexcept -> bool
+        {
+            return std::ranges::find(access.reads, id) != access.reads.end() || std::ranges::find(access.writes, id) != access.writes.end();
+        };
+        return std::ranges::any_of(writes, [&](ComponentTypeID id) noexcept { return touches(other, id); })
+            || std::ranges::any_of(other.writes, [&](ComponentTypeID id) noexcept { return touches(*this, id); });
+    }
+};
+
+// Helper to collect the access set of a system, a single ComponentType is written, const entries of ComponentTypes are read
+template<class System>
+struct SystemAccessOf
+{
+    [[nodiscard]] static SystemAccess get() noexcept
+    {
+        return SystemAccess{ {}, { componentTypeID<typename System::ComponentType>() } };
+    }
+};
+
+template<class System> requires requires { typename System::ComponentTypes; }
+struct SystemAccessOf<System>
+{
+    [[nodiscard]] static SystemAccess get() noexcept
+    {
+        SystemAccess access{};
+        collect(access, std::type_identity<typename System::ComponentTypes>{});
+        return access;
+    }
+
+private:
+    template<class... Components>
+    static void collect(SystemAccess& access, std::type_identity<std::tuple<Components...>>) noexcept
+    {
+        ((std::is_const_v<Components> ? access.reads : access.writes).push_back(componentTypeID<std::remove_const_t<Components>>()), ...);
+    }
+};
+
+// Helper to get the component types a system accesses as a tuple, const entries are read and the others written
+template<class System>
+struct SystemComponentsOfHelper
+{
+    using type = std::tuple<typename System::ComponentType>;
+};
+
+template<class System> requires requires { typename System::ComponentTypes; }
+struct SystemComponentsOfHelper<System>
+{
+    using type = typename System::ComponentTypes;
+};
+
+template<class System>
+using SystemComponentsOf = typename SystemComponentsOfHelper<System>::type;
+
+// Check at compile time if a component access conflicts with any of others, same type and at least one write
+template<class Component, class... Others>
+inline constexpr bool AccessConflicts = ((std::same_as<std::remove_const_t<Component>, std::remove_const_t<Others>> && !(std::is_const_v<Component> && std::is_const_v<Others>)) || ...);
+
+template<class First, class Second>
+struct ComponentsConflict;
+
+template<class... First, class... Second>
+struct ComponentsConflict<std::tuple<First...>, std::tuple<Second...>> : std::bool_constant<(AccessConflicts<First, Second...> || ...)> {};
+
+// Check at compile time if two systems touch a common component type and at least one of them writes it
+template<class First, class Second>
+inline constexpr bool SystemsConflict = ComponentsConflict<SystemComponentsOf<First>, SystemComponentsOf<Second>>::value;
+
+// Duplicate handling of bulk insertions
+enum class BulkPolicy : std::uint8_t
+{
+    Checked, // Skip entities that already have the component
+    AssumeUnique // The caller vouches that no entity has the component yet and no entity appears twice
+};
+
+// Order guarantee when removing an entity from a dense array
+enum class RemovalOrder : std::uint8_t
+{
+    SwapAndPop, // Move the last entry into the freed slot, O(1) but reorders the last entry
+    Stable // Shift every later entry down one slot, O(n) but keeps the iteration order
+};
+
+// Get the number of bytes shrinkArray would move, zero while at least half of the capacity is used
+template<class T, class Allocator>
+[[nodiscard]] std::size_t shrinkCost(const std::vector<T, Allocator>& array) noexcept
+{
+    return array.capacity() <= 2 * array.size() ? 0 : array.size() * sizeof(T);
+}
+
+// Reallocate a vector to fit its contents once less than half of its capacity is used, returns the number of bytes moved
+template<class T, class Allocator>
+std::size_t shrinkArray(std::vector<T, Allocator>& array) noexcept
+{
+    const std::size_t cost = shrinkCost(array);
+    if (array.capacity() > 2 * array.size())
+        array.shrink_to_fit();
+    return cost;
+}
+
+// Sparse set mapping entity IDs to slots of a dense entity array through a paged sparse index
+// The sparse index is addressed by entity index, the dense array holds full IDs so a stale generation never matches
+class SparseSet final
+{
+    static constexpr std::size_t PageSize = 4096; // Number of sparse entries per page
+    static constexpr Entity::IDType Tombstone = std::numeric_limits<Entity::IDType>::max(); // Marks an unused sparse entry
+public:
+    explicit SparseSet(std::pmr::memory_resource* resource = std::pmr::get_default_resource()) noexcept : m_sparse{ resource }, m_dense{ resource } {}
+
+    // Check if the set contains an entity
+    [[nodiscard]] bool contains(Entity::IDType entityID) const noexcept
+    {
+        const std::size_t page = Entity::indexOf(entityID) / PageSize;
+        if (page >= m_sparse.size() || m_sparse[page].empty())
+            return false;
+
+        const Entity::IDType slot = m_sparse[page][Entity::indexOf(entityID) % PageSize];
+        return slot != Tombstone && m_dense[slot] == entityID;
+    }
+
+    // Get the dense slot of an entity, the entity must be in the set
+    [[nodiscard]] std::size_t index(Entity::IDType entityID) const noexcept
+    {
+        return m_sparse[Entity::indexOf(entityID) / PageSize][Entity::indexOf(entityID) % PageSize];
+    }
+
+    // Append an entity to the end of the dense array, returns false if its index is taken by this or any other generation
+    bool push(Entity::IDType entityID) noexcept
+    {
+        Entity::IDType& entry = sparseEntry(entityID);
+        if (entry != Tombstone)
+            return false;
+
+        entry = static_cast<Entity::IDType>(m_dense.size());
+        m_dense.push_back(entityID);
+        return true;
+    }
+
+    // Remove an entity by moving the last entity into its slot, the entity must be in the set
+    void swapAndPop(Entity::IDType entityID) noexcept
+    {
+        const std::size_t slot = index(entityID);
+        const Entity::IDType last = m_dense.back();
+        m_dense[slot] = last;
+        sparseEntry(last) = static_cast<Entity::IDType>(slot);
+        sparseEntry(entityID) = Tombstone;
+        m_dense.pop_back();
+    }
+
+    // Swap the entities of two slots, an erased slot keeps no sparse entry
+    void swapSlots(std::size_t first, std::size_t second) noexcept
+    {
+        std::swap(m_dense[first], m_dense[second]);
+        if (m_dense[first] != Tombstone)
+            sparseEntry(m_dense[first]) = static_cast<Entity::IDType>(first);
+        if (m_dense[second] != Tombstone)
+            sparseEntry(m_dense[second]) = static_cast<Entity::IDType>(second);
+    }
+
+    // Remove an entity by shifting every later entity down one slot, the entity must be in the set
+    void shiftErase(Entity::IDType entityID) noexcept
+    {
+        const std::size_t slot = index(entityID);
+        sparseEntry(entityID) = Tombstone;
+        m_dense.erase(m_dense.begin() + static_cast<std::ptrdiff_t>(slot));
+        for (std::size_t i = slot; i < m_dense.size(); ++i)
+            sparseEntry(m_dense[i]) = static_cast<Entity::IDType>(i);
+    }
+
+    // Mark an entity as erased without moving anything, the entity must be in the set and compact must follow
+    void markErased(Entity::IDType entityID) noexcept
+    {
+        const std::size_t slot = index(entityID);
+        sparseEntry(entityID) = Tombstone;
+        m_dense[slot] = Tombstone;
+    }
+
+    // Remove every marked slot in a single order preserving pass, moveSlot(from, to) is called for every moved entity
+    template<class Func> requires std::is_nothrow_invocable_v<Func&, std::size_t, std::size_t>
+    void compact(Func&& moveSlot) noexcept
+    {
+        std::size_t write = 0;
+        for (std::size_t read = 0; read < m_dense.size(); ++read)
+        {
+            if (m_dense[read] == Tombstone)
+                continue;
+
+            if (read != write)
+            {
+                m_dense[write] = m_dense[read];
+                sparseEntry(m_dense[write]) = static_cast<Entity::IDType>(write);
+                moveSlot(read, write);
+            }
+            ++write;
+        }
+        m_dense.resize(write);
+    }
+
+    // Reserve room for a number of entities in the dense array
+    void reserve(std::size_t capacity) noexcept
+    {
+        m_dense.reserve(capacity);
+    }
+
+    // Replace the contents of the set with unique entities, they keep their order
+    void assign(std::span<const Entity::IDType> entityIDs) noexcept
+    {
+        m_sparse.clear();
+        m_dense.assign(entityIDs.begin(), entityIDs.end());
+        for (std::size_t slot = 0; slot < m_dense.size(); ++slot)
+            sparseEntry(m_dense[slot]) = static_cast<Entity::IDType>(slot);
+    }
+
+    // Get the dense array of entity IDs
+    [[nodiscard]] std::span<const Entity::IDType> entities() const noexcept { return m_dense; }
+
+    // Get the number of entities the dense array has room for
+    [[nodiscard]] std::size_t capacity() const noexcept { return m_dense.capacity(); }
+
+    // Get the number of allocated sparse pages
+    [[nodiscard]] std::size_t pageCount() const noexcept
+    {
+        return static_cast<std::size_t>(std::ranges::count_if(m_sparse, [](const std::pmr::vector<Entity::IDType>& page) noexcept { return !page.empty(); }));
+    }
+
+    // Get the number of sparse page slots, allocated or not
+    [[nodiscard]] std::size_t pageSlots() const noexcept { return m_sparse.size(); }
+
+    // Get the bytes allocated by the sparse index and the dense array
+    [[nodiscard]] std::size_t bytes() const noexcept
+    {
+        return m_sparse.capacity() * sizeof(std::pmr::vector<Entity::IDType>) + pageCount() * PageSize * sizeof(Entity::IDType)
+            + m_dense.capacity() * sizeof(Entity::IDType);
+    }
+
+    // Get the number of bytes shrinkDense would move
+    [[nodiscard]] std::size_t shrinkDenseCost() const noexcept
+    {
+        return shrinkCost(m_dense) + shrinkCost(m_sparse);
+    }
+
+    // Shrink the dense array and the page table once they are less than half full, returns the number of bytes moved
+    std::size_t shrinkDense() noexcept
+    {
+        return shrinkArray(m_dense) + shrinkArray(m_sparse);
+    }
+
+    // Get the number of bytes releaseEmptyPages would scan
+    [[nodiscard]] std::size_t releaseEmptyPagesCost(std::size_t first, std::size_t count) const noexcept
+    {
+        std::size_t allocated = 0;
+        for (std::size_t page = first; page < std::min(first + count, m_sparse.size()); ++page)
+            allocated += m_sparse[page].empty() ? 0 : 1;
+        return allocated * PageSize * sizeof(Entity::IDType);
+    }
+
+    // Free the allocated sparse pages in [first, first + count) that hold no entity, returns the number of bytes scanned
+    std::size_t releaseEmptyPages(std::size_t first, std::size_t count) noexcept
+    {
+        std::size_t scanned = 0;
+        for (std::size_t page = first; page < std::min(first + count, m_sparse.size()); ++page)
+        {
+            if (m_sparse[page].empty())
+                continue;
+
+            scanned += PageSize * sizeof(Entity::IDType);
+            if (std::ranges::all_of(m_sparse[page], [](Entity::IDType slot) noexcept { return slot == Tombstone; }))
+            {
+                m_sparse[page].clear();
+                m_sparse[page].shrink_to_fit();
+            }
+        }
+
+        // Unallocated pages at the end need no slot in the page table
+        while (!m_sparse.empty() && m_sparse.back().empty())
+            m_sparse.pop_back();
+        return scanned;
+    }
+
+    // Get the number of entities in the set
+    [[nodiscard]] std::size_t size() const noexcept { return m_dense.size(); }
+
+private:
+    // Get the sparse entry of an entity, allocating its page if needed
+    [[nodiscard]] Entity::IDType& sparseEntry(Entity::IDType entityID) noexcept
+    {
+        const std::size_t page = Entity::indexOf(entityID) / PageSize;
+        if (page >= m_sparse.size())
+            m_sparse.resize(page + 1);
+        if (m_sparse[page].empty())
+            m_sparse[page].resize(PageSize, Tombstone);
+        return m_sparse[page][Entity::indexOf(entityID) % PageSize];
+    }
+
+    std::pmr::vector<std::pmr::vector<Entity::IDType>> m_sparse{}; // Paged sparse index from entity ID to dense slot, empty pages are unallocated
+    std::pmr::vector<Entity::IDType> m_dense{}; // Dense array of entity IDs
+};
+
+// Bytes a shrinkToFit call may still move or scan, the first step of a call always runs so every call makes progress
+struct ShrinkBudget final
+{
+    std::size_t bytes{}; // Bytes left for the call
+    bool stepped{}; // Whether a step already ran during the call
+
+    // Check if the call has to stop, once a step ran and the bytes are used up
+    [[nodiscard]] bool spent() const noexcept { return stepped && bytes == 0; }
+
+    // Reserve the bytes of the next step, returns false to leave a step that does not fit the rest of the budget to the next call
+    bool take(std::size_t cost) noexcept
+    {
+        if (stepped && cost > bytes)
+            return false;
+
+        bytes -= std::min(bytes, std::max(cost, std::size_t{ 1 }));
+        stepped = true;
+        return true;
+    }
+};
+
+// Memory held by a pool
+struct PoolStats final
+{
+    std::size_t size{}; // Number of components
+    std::size_t capacity{}; // Number of components the dense arrays have room for
+    std::size_t bytes{}; // Bytes allocated by the dense arrays and the sparse index
+    std::size_t sparsePages{}; // Number of allocated sparse pages
+    double fragmentation{}; // Share of the allocated bytes holding nothing, from 0 to 1
+};
+
+// Components of a pool as one raw block, the component of entities[i] starts at data + i * stride
+struct ComponentBlock final
+{
+    std::span<const Entity::IDType> entities{};
+    std::byte* data{};
+    std::size_t stride{};
+};
+
+// Identifier of an observer connected to a pool, used to disconnect it
+using ObserverID = std::uint32_t;
+
+// Observer called with one entity that gained or is about to lose a component
+using EntityObserver = std::function<void(Entity::IDType)>;
+
+// Observer called with a contiguous batch of entities that gained or lost a component
+using BatchObserver = std::function<void(std::span<const Entity::IDType>)>;
+
+// Type-erased interface of a component pool, lets a world own the pools of every component type in one table
+// Every pool also carries the add and remove observers of its component type, observers may reorder the pool they observe but must not add or remove its components
+class PoolBase
+{
+public:
+    virtual ~PoolBase() noexcept = default;
+
+    // Check if an entity has a component in the pool
+    [[nodiscard]] virtual bool contains(Entity::IDType entityID) const noexcept = 0;
+
+    // Remove the component of an entity, returns false if the entity has none
+    virtual bool remove(Entity::IDType entityID) noexcept = 0;
+
+    // Get the number of components in the pool
+    [[nodiscard]] virtual std::size_t size() const noexcept = 0;
+
+    // Get the memory held by the pool
+    [[nodiscard]] virtual PoolStats stats() const noexcept = 0;
+
+    // Give memory the pool no longer uses back, step by step from a cursor while a budget of bytes to move or scan lasts
+    // Returns true once every step is done, a step larger than what is left of the budget waits for the next call
+    virtual bool shrinkToFit(std::size_t& cursor, ShrinkBudget& budget) noexcept = 0;
+
+    // Get the components as one raw block, for code that only knows the component type at runtime
+    // Empty for pools without a single dense component array
+    [[nodiscard]] virtual ComponentBlock block() noexcept { return ComponentBlock{}; }
+
+    // Get a raw pointer to the component of an entity, or nullptr if it has none or the pool has no single dense component array
+    [[nodiscard]] virtual void* tryGetRaw([[maybe_unused]] Entity::IDType entityID) noexcept { return nullptr; }
+
+    // Move a component out of raw memory into the pool, returns false if the entity already has one or the pool takes no raw components
+    virtual bool emplaceRaw([[maybe_unused]] Entity::IDType entityID, [[maybe_unused]] void* source) noexcept { return false; }
+
+    // Connect an observer called right after an entity gained a component
+    ObserverID connectOnAdd(EntityObserver observer) noexcept
+    {
+        m_onAdd.push_back(Observer<EntityObserver>{ m_nextObserverID, std::move(observer) });
+        return m_nextObserverID++;
+    }
+
+    // Connect an observer called right before an entity loses a component, the component is still readable
+    ObserverID connectOnRemove(EntityObserver observer) noexcept
+    {
+        m_onRemove.push_back(Observer<EntityObserver>{ m_nextObserverID, std::move(observer) });
+        return m_nextObserverID++;
+    }
+
+    // Connect an observer called with the entities that gained a component, once per batch or once per change outside of batches
+    ObserverID connectOnAddBatch(BatchObserver observer) noexcept
+    {
+        m_onAddBatch.push_back(Observer<BatchObserver>{ m_nextObserverID, std::move(observer) });
+        return m_nextObserverID++;
+    }
+
+    // Connect an observer called with the entities that lost a component, once per batch or once per change outside of batches
+    ObserverID connectOnRemoveBatch(BatchObserver observer) noexcept
+    {
+        m_onRemoveBatch.push_back(Observer<BatchObserver>{ m_nextObserverID, std::move(observer) });
+        return m_nextObserverID++;
+    }
+
+    // Disconnect an observer of any kind
+    void disconnect(ObserverID id) noexcept
+    {
+        std::erase_if(m_onAdd, [id](const Observer<EntityObserver>& observer) noexcept { return observer.id == id; });
+        std::erase_if(m_onRemove, [id](const Observer<EntityObserver>& observer) noexcept { return observer.id == id; });
+        std::erase_if(m_onAddBatch, [id](const Observer<BatchObserver>& observer) noexcept { return observer.id == id; });
+        std::erase_if(m_onRemoveBatch, [id](const Observer<BatchObserver>& observer) noexcept { return observer.id == id; });
+    }
+
+    // Start collecting the entities for batch observers instead of delivering them per change, batches nest
+    void beginBatch() noexcept
+    {
+        ++m_batchDepth;
+    }
+
+    // End a batch, the outermost one delivers everything collected since it began as one span per observer kind
+    void endBatch() noexcept
+    {
+        if (--m_batchDepth != 0)
+            return;
+
+        deliver(m_onAddBatch, m_pendingAdded);
+        deliver(m_onRemoveBatch, m_pendingRemoved);
+    }
+
+protected:
+    // Measure a pool made of a sparse set and dense arrays parallel to it
+    template<class... Arrays>
+    [[nodiscard]] static PoolStats measure(const SparseSet& set, std::size_t capacity, const Arrays&... arrays) noexcept
+    {
+        return measureBytes(set, capacity, (std::size_t{ 0 } + ... + (arrays.capacity() * sizeof(typename Arrays::value_type))),
+            (std::size_t{ 0 } + ... + (arrays.size() * sizeof(typename Arrays::value_type))));
+    }
+
+    // Measure a pool made of a sparse set and dense arrays allocating and using the given number of bytes
+    [[nodiscard]] static PoolStats measureBytes(const SparseSet& set, std::size_t capacity, std::size_t arrayBytes, std::size_t arrayUsed) noexcept
+    {
+        const std::size_t bytes = set.bytes() + arrayBytes;
+        // Every entity uses its dense slot and one sparse entry
+        const std::size_t used = set.size() * 2 * sizeof(Entity::IDType) + arrayUsed;
+        return PoolStats
+        {
+            .size = set.size(),
+            .capacity = capacity,
+            .bytes = bytes,
+            .sparsePages = set.pageCount(),
+            .fragmentation = bytes == 0 ? 0.0 : 1.0 - static_cast<double>(std::min(used, bytes)) / static_cast<double>(bytes)
+        };
+    }
+
+    // Run the steps of shrinking a pool made of a sparse set and dense arrays: the entity array, every other array, then runs of sparse pages
+    template<class... Arrays>
+    static bool shrinkSteps(SparseSet& set, std::size_t& cursor, ShrinkBudget& budget, Arrays&... arrays) noexcept
+    {
+        static constexpr std::size_t PagesPerStep = 16;
+        while (!budget.spent())
+        {
+            if (cursor == 0)
+            {
+                if (!budget.take(set.shrinkDenseCost()))
+                    return false;
+                set.shrinkDense();
+            }
+            else if (cursor <= sizeof...(Arrays))
+            {
+                std::size_t cost = 0;
+                std::size_t index = 1;
+                ((index++ == cursor ? static_cast<void>(cost = shrinkCost(arrays)) : static_cast<void>(0)), ...);
+                if (!budget.take(cost))
+                    return false;
+                index = 1;
+                ((index++ == cursor ? static_cast<void>(shrinkArray(arrays)) : static_cast<void>(0)), ...);
+            }
+            else
+            {
+                const std::size_t firstPage = (cursor - 1 - sizeof...(Arrays)) * PagesPerStep;
+                if (firstPage >= set.pageSlots())
+                    return true;
+                if (!budget.take(set.releaseEmptyPagesCost(firstPage, PagesPerStep)))
+                    return false;
+                set.releaseEmptyPages(firstPage, PagesPerStep);
+            }
+            ++cursor;
+        }
+        return false;
+    }
+
+    // Notify the observers that an entity gained a component
+    void notifyAdded(Entity::IDType entityID) noexcept
+    {
+        for (const Observer<EntityObserver>& observer : m_onAdd)
+            observer.callback(entityID);
+        notifyBatch(m_onAddBatch, m_pendingAdded, entityID);
+    }
+
+    // Notify the observers that an entity is about to lose a component
+    void notifyRemoving(Entity::IDType entityID) noexcept
+    {
+        for (const Observer<EntityObserver>& observer : m_onRemove)
+            observer.callback(entityID);
+    }
+
+    // Notify the batch observers that an entity lost a component
+    void notifyRemoved(Entity::IDType entityID) noexcept
+    {
+        notifyBatch(m_onRemoveBatch, m_pendingRemoved, entityID);
+    }
+
+private:
+    template<class Callback>
+    struct Observer final
+    {
+        ObserverID id{};
+        Callback callback{};
+    };
+
+    // Deliver one entity to the batch observers right away, or collect it while a batch is open
+    void notifyBatch(const std::vector<Observer<BatchObserver>>& observers, std::vector<Entity::IDType>& pending, Entity::IDType entityID) noexcept
+    {
+        if (observers.empty())
+            return;
+
+        if (m_batchDepth != 0)
+            pending.push_back(entityID);
+        else
+            for (const Observer<BatchObserver>& observer : observers)
+                observer.callback(std::span<const Entity::IDType>{ &entityID, 1 });
+    }
+
+    // Deliver the collected entities to the batch observers and reset the collection
+    static void deliver(const std::vector<Observer<BatchObserver>>& observers, std::vector<Entity::IDType>& pending) noexcept
+    {
+        if (!pending.empty())
+            for (const Observer<BatchObserver>& observer : observers)
+                observer.callback(pending);
+        pending.clear();
+    }
+
+    std::vector<Observer<EntityObserver>> m_onAdd{};
+    std::vector<Observer<EntityObserver>> m_onRemove{};
+    std::vector<Observer<BatchObserver>> m_onAddBatch{};
+    std::vector<Observer<BatchObserver>> m_onRemoveBatch{};
+    std::vector<Entity::IDType> m_pendingAdded{}; // Entities collected for the add batch observers
+    std::vector<Entity::IDType> m_pendingRemoved{}; // Entities collected for the remove batch observers
+    std::uint32_t m_batchDepth{};
+    ObserverID m_nextObserverID{};
+};
+
+// Tick counter of a world, used to stamp when components were last added or changed
+using Tick = std::uint32_t;
+
+// Pool storing the components of one type, keeps entity IDs and components in parallel dense arrays
+// With change tracking enabled a third parallel array stamps every component with the tick it was last added or changed at
+template<ComponentConcept Component>
+class ComponentPool final : public PoolBase
+{
+public:
+    explicit ComponentPool(std::pmr::memory_resource* resource = std::pmr::get_default_resource()) noexcept
+        : m_set{ resource }, m_components{ resource }, m_changeTicks{ resource } {}
+
+    // Check if an entity has a component in the pool
+    [[nodiscard]] bool contains(Entity::IDType entityID) const noexcept override
+    {
+        return m_set.contains(entityID);
+    }
+
+    // Remove the component of an entity with swap-and-pop, returns false if the entity has none
+    bool remove(Entity::IDType entityID) noexcept override
+    {
+        return erase(entityID);
+    }
+
+    // Get a pointer to the component of an entity, or nullptr if the entity has none
+    [[nodiscard]] Component* tryGet(Entity::IDType entityID) noexcept
+    {
+        return m_set.contains(entityID) ? &m_components[m_set.index(entityID)] : nullptr;
+    }
+
+    // Get a pointer to the component of an entity for reading, or nullptr if the entity has none
+    [[nodiscard]] const Component* tryGet(Entity::IDType entityID) const noexcept
+    {
+        return m_set.contains(entityID) ? &m_components[m_set.index(entityID)] : nullptr;
+    }
+
+    // Get the component of an entity, the entity must have one
+    [[nodiscard]] Component& get(Entity::IDType entityID) noexcept
+    {
+        return m_components[m_set.index(entityID)];
+    }
+
+    // Add a component to an entity, returns false if the entity already has one
+    bool emplace(Entity::IDType entityID, Component&& component) noexcept
+    {
+        if (!m_set.push(entityID))
+            return false;
+
+        m_components.push_back(std::move(component));
+        if (tracksChanges())
+            m_changeTicks.push_back(*m_tick);
+        notifyAdded(entityID);
+        return true;
+    }
+
+    // Remove the component of an entity, returns false if the entity has none
+    bool erase(Entity::IDType entityID, RemovalOrder order = RemovalOrder::SwapAndPop) noexcept
+    {
+        if (!m_set.contains(entityID))
+            return false;
+
+        notifyRemoving(entityID);
+        const std::size_t slot = m_set.index(entityID);
+        if (order == RemovalOrder::Stable)
+        {
+            m_components.erase(m_components.begin() + static_cast<std::ptrdiff_t>(slot));
+            if (tracksChanges())
+                m_changeTicks.erase(m_changeTicks.begin() + static_cast<std::ptrdiff_t>(slot));
+            m_set.shiftErase(entityID);
+            notifyRemoved(entityID);
+            return true;
+        }
+
+        if (slot != m_components.size() - 1)
+            m_components[slot] = std::move(m_components.back());
+        m_components.pop_back();
+        if (tracksChanges())
+        {
+            m_changeTicks[slot] = m_changeTicks.back();
+            m_changeTicks.pop_back();
+        }
+        m_set.swapAndPop(entityID);
+        notifyRemoved(entityID);
+        return true;
+    }
+
+    // Add components to entities, growing the dense arrays once and notifying the batch observers once
+    void insert(std::span<const Entity::IDType> entityIDs, std::span<Component> components, BulkPolicy policy) noexcept
+    {
+        beginBatch();
+        m_set.reserve(m_set.size() + entityIDs.size());
+        m_components.reserve(m_components.size() + entityIDs.size());
+        if (policy == BulkPolicy::AssumeUnique)
+        {
+            const std::size_t first = m_set.size();
+            for (std::size_t i = 0; i < entityIDs.size(); ++i)
+                if (m_set.push(entityIDs[i]))
+                    m_components.push_back(std::move(components[i]));
+            if (tracksChanges())
+                m_changeTicks.resize(m_components.size(), *m_tick);
+            for (const Entity::IDType entityID : m_set.entities().subspan(first))
+                notifyAdded(entityID);
+        }
+        else
+            for (std::size_t i = 0; i < entityIDs.size(); ++i)
+                emplace(entityIDs[i], std::move(components[i]));
+        endBatch();
+    }
+
+    // Remove the components of entities, stable removal compacts the dense arrays in a single pass, returns the number removed
+    std::size_t erase(std::span<const Entity::IDType> entityIDs, RemovalOrder order) noexcept
+    {
+        beginBatch();
+        if (order == RemovalOrder::SwapAndPop)
+        {
+            const std::size_t removed = static_cast<std::size_t>(std::ranges::count_if(entityIDs, [this](Entity::IDType entityID) noexcept { return erase(entityID); }));
+            endBatch();
+            return removed;
+        }
+
+        std::size_t removed = 0;
+        for (const Entity::IDType entityID : entityIDs)
+            if (m_set.contains(entityID))
+            {
+                notifyRemoving(entityID);
+                m_set.markErased(entityID);
+                notifyRemoved(entityID);
+                ++removed;
+            }
+
+        if (removed != 0)
+        {
+            m_set.compact([this](std::size_t from, std::size_t to) noexcept
+            {
+                m_components[to] = std::move(m_components[from]);
+                if (tracksChanges())
+                    m_changeTicks[to] = m_changeTicks[from];
+            });
+            m_components.resize(m_set.size());
+            if (tracksChanges())
+                m_changeTicks.resize(m_set.size());
+        }
+        endBatch();
+        return removed;
+    }
+
+    // Swap the components of two slots together with their entities and change ticks
+    void swapSlots(std::size_t first, std::size_t second) noexcept
+    {
+        if (first == second)
+            return;
+
+        m_set.swapSlots(first, second);
+        std::ranges::swap(m_components[first], m_components[second]);
+        if (tracksChanges())
+            std::swap(m_changeTicks[first], m_changeTicks[second]);
+    }
+
+    // Sort the components in place, entities and change ticks follow their components and the sparse index is fixed up
+    template<class Compare> requires std::is_nothrow_invocable_r_v<bool, Compare&, const Component&, const Component&>
+    void sort(Compare compare) noexcept
+    {
+        std::vector<std::size_t> order(m_components.size());
+        std::iota(order.begin(), order.end(), std::size_t{ 0 });
+        std::ranges::sort(order, [this, &compare](std::size_t first, std::size_t second) noexcept { return compare(m_components[first], m_components[second]); });
+
+        // Walk every cycle of the permutation once, each swap puts one slot in its final place
+        for (std::size_t slot = 0; slot < order.size(); ++slot)
+        {
+            std::size_t current = slot;
+            while (order[current] != slot)
+            {
+                const std::size_t next = order[current];
+                swapSlots(current, next);
+                order[current] = current;
+                current = next;
+            }
+            order[current] = current;
+        }
+    }
+
+    // Sort the components in the order of a sequence of entities, entities missing from the sequence end up after the others
+    void sortAs(std::span<const Entity::IDType> entityIDs) noexcept
+    {
+        std::size_t slot = 0;
+        for (const Entity::IDType entityID : entityIDs)
+            if (m_set.contains(entityID))
+                swapSlots(slot++, m_set.index(entityID));
+    }
+
+    // Get the slot of an entity in the dense arrays, the entity must have a component
+    [[nodiscard]] std::size_t index(Entity::IDType entityID) const noexcept
+    {
+        return m_set.index(entityID);
+    }
+
+    // Reserve room for a number of components
+    void reserve(std::size_t capacity) noexcept
+    {
+        m_set.reserve(capacity);
+        m_components.reserve(capacity);
+        if (tracksChanges())
+            m_changeTicks.reserve(capacity);
+    }
+
+    // Start stamping components with the tick they were last added or changed at, existing components count as changed now
+    void enableChangeTracking(const Tick* tick) noexcept
+    {
+        m_tick = tick;
+        m_changeTicks.assign(m_components.size(), *m_tick);
+    }
+
+    // Check if the pool stamps changes
+    [[nodiscard]] bool tracksChanges() const noexcept { return m_tick != nullptr; }
+
+    // Stamp the component of an entity as changed at the current tick, does nothing without change tracking
+    void markChanged(Entity::IDType entityID) noexcept
+    {
+        if (tracksChanges() && m_set.contains(entityID))
+            m_changeTicks[m_set.index(entityID)] = *m_tick;
+    }
+
+    // Stamp every component as changed at the current tick, does nothing without change tracking
+    void markAllChanged() noexcept
+    {
+        if (tracksChanges())
+            std::ranges::fill(m_changeTicks, *m_tick);
+    }
+
+    // Get the tick every component was last added or changed at, parallel to the component array and empty without change tracking
+    [[nodiscard]] std::span<const Tick> changeTicks() const noexcept { return m_changeTicks; }
+
+    // Get the dense array of entity IDs, parallel to the component array
+    [[nodiscard]] std::span<const Entity::IDType> entities() const noexcept { return m_set.entities(); }
+
+    // Get the dense array of components
+    [[nodiscard]] std::span<Component> components() noexcept { return m_components; }
+
+    // Get the dense array of components for reading
+    [[nodiscard]] std::span<const Component> components() const noexcept { return m_components; }
+
+    // Replace the contents of the pool with parallel arrays of entity IDs and components, observers are not notified
+    void assign(std::span<const Entity::IDType> entityIDs, std::span<const Component> components) noexcept
+    {
+        m_set.assign(entityIDs);
+        m_components.assign(components.begin(), components.end());
+        if (tracksChanges())
+            m_changeTicks.assign(m_components.size(), *m_tick);
+    }
+
+    // Get the number of components in the pool
+    [[nodiscard]] std::size_t size() const noexcept override { return m_components.size(); }
+
+    [[nodiscard]] PoolStats stats() const noexcept override
+    {
+        return measure(m_set, m_components.capacity(), m_components, m_changeTicks);
+    }
+
+    bool shrinkToFit(std::size_t& cursor, ShrinkBudget& budget) noexcept override
+    {
+        return shrinkSteps(m_set, cursor, budget, m_components, m_changeTicks);
+    }
+
+    [[nodiscard]] ComponentBlock block() noexcept override
+    {
+        return ComponentBlock{ m_set.entities(), reinterpret_cast<std::byte*>(m_components.data()), sizeof(Component) };
+    }
+
+    [[nodiscard]] void* tryGetRaw(Entity::IDType entityID) noexcept override
+    {
+        return tryGet(entityID);
+    }
+
+    bool emplaceRaw(Entity::IDType entityID, void* source) noexcept override
+    {
+        return emplace(entityID, std::move(*static_cast<Component*>(source)));
+    }
+
+private:
+    SparseSet m_set{}; // Mapping from entity ID to dense slot
+    std::pmr::vector<Component> m_components{}; // Dense array of components
+    std::pmr::vector<Tick> m_changeTicks{}; // Tick every component was last added or changed at
+    const Tick* m_tick{}; // Current tick of the owning world, nullptr without change tracking
+};
+
+// Helper to map the member pointers of a structure-of-arrays layout to column types
+template<class MemberTuple>
+struct SoAColumnsOf;
+
+template<class Component, class... Members>
+struct SoAColumnsOf<std::tuple<Members Component::*...>>
+{
+    using Vectors = std::tuple<std::pmr::vector<Members>...>; // Storage of every member column
+    using Spans = std::tuple<std::span<Members>...>; // Contiguous view of every member column
+
+    // Create empty columns allocating from a memory resource
+    [[nodiscard]] static Vectors make(std::pmr::memory_resource* resource) noexcept
+    {
+        return Vectors{ std::pmr::vector<Members>(resource)... };
+    }
+};
+
+// Helper to check if a system is callable with the member columns of a component and arguments
+template<class System, class SpanTuple, class... Args>
+struct IsSoASystem : std::false_type {};
+
+template<class System, class... Spans, class... Args>
+struct IsSoASystem<System, std::tuple<Spans...>, Args...> : std::bool_constant<std::is_nothrow_invocable_v<System&, Spans..., Args...>> {};
+
+// Concept to ensure a type is a valid system over the member columns of a structure-of-arrays component
+template<class System, class... Args>
+concept SoASystemConcept =
+    requires
+    {
+        typename System::ComponentType; // System must define a ComponentType
+    } && std::default_initializable<System> && SoAComponentConcept<typename System::ComponentType>
+    && IsSoASystem<System, typename SoAColumnsOf<std::remove_cvref_t<decltype(SoALayout<typename System::ComponentType>::members)>>::Spans, Args...>::value;
+
+// Pool storing the components of one type as structure of arrays, every member of the layout gets its own dense column
+template<SoAComponentConcept Component>
+class SoAPool final : public PoolBase
+{
+    static constexpr auto Members = SoALayout<Component>::members;
+    static constexpr std::size_t MemberCount = std::tuple_size_v<std::remove_cvref_t<decltype(Members)>>;
+
+    using Columns = SoAColumnsOf<std::remove_cvref_t<decltype(Members)>>;
+public:
+    using Spans = typename Columns::Spans;
+
+    explicit SoAPool(std::pmr::memory_resource* resource = std::pmr::get_default_resource()) noexcept : m_set{ resource }, m_columns{ Columns::make(resource) } {}
+
+    // Check if an entity has a component in the pool
+    [[nodiscard]] bool contains(Entity::IDType entityID) const noexcept override
+    {
+        return m_set.contains(entityID);
+    }
+
+    // Remove the component of an entity with swap-and-pop, returns false if the entity has none
+    bool remove(Entity::IDType entityID) noexcept override
+    {
+        return erase(entityID);
+    }
+
+    // Add a component to an entity by scattering its members into the columns, returns false if the entity already has one
+    bool emplace(Entity::IDType entityID, Component&& component) noexcept
+    {
+        if (!m_set.push(entityID))
+            return false;
+
+        forEachColumn([&component]<std::size_t I>(auto& column, std::integral_constant<std::size_t, I>) noexcept
+        {
+            column.push_back(std::move(component.*std::get<I>(Members)));
+        });
+        notifyAdded(entityID);
+        return true;
+    }
+
+    // Remove the component of an entity from every column, returns false if the entity has none
+    bool erase(Entity::IDType entityID, RemovalOrder order = RemovalOrder::SwapAndPop) noexcept
+    {
+        if (!m_set.contains(entityID))
+            return false;
+
+        notifyRemoving(entityID);
+        const std::size_t slot = m_set.index(entityID);
+        forEachColumn([slot, order]<std::size_t I>(auto& column, std::integral_constant<std::size_t, I>) noexcept
+        {
+            if (order == RemovalOrder::Stable)
+                column.erase(column.begin() + static_cast<std::ptrdiff_t>(slot));
+            else
+            {
+                if (slot != column.size() - 1)
+                    column[slot] = std::move(column.back());
+                column.pop_back();
+            }
+        });
+        if (order == RemovalOrder::Stable)
+            m_set.shiftErase(entityID);
+        else
+            m_set.swapAndPop(entityID);
+        notifyRemoved(entityID);
+        return true;
+    }
+
+    // Add components to entities, growing every column once and notifying the batch observers once
+    void insert(std::span<const Entity::IDType> entityIDs, std::span<Component> components, BulkPolicy policy) noexcept
+    {
+        beginBatch();
+        m_set.reserve(m_set.size() + entityIDs.size());
+        forEachColumn([&entityIDs]<std::size_t I>(auto& column, std::integral_constant<std::size_t, I>) noexcept
+        {
+            column.reserve(column.size() + entityIDs.size());
+        });
+        for (std::size_t i = 0; i < entityIDs.size(); ++i)
+        {
+            if (policy == BulkPolicy::AssumeUnique)
+            {
+                if (!m_set.push(entityIDs[i]))
+                    continue;
+                forEachColumn([&components, i]<std::size_t I>(auto& column, std::integral_constant<std::size_t, I>) noexcept
+                {
+                    column.push_back(std::move(components[i].*std::get<I>(Members)));
+                });
+                notifyAdded(entityIDs[i]);
+            }
+            else
+                emplace(entityIDs[i], std::move(components[i]));
+        }
+        endBatch();
+    }
+
+    // Remove the components of entities, stable removal compacts every column in a single pass, returns the number removed
+    std::size_t erase(std::span<const Entity::IDType> entityIDs, RemovalOrder order) noexcept
+    {
+        beginBatch();
+        if (order == RemovalOrder::SwapAndPop)
+        {
+            const std::size_t removed = static_cast<std::size_t>(std::ranges::count_if(entityIDs, [this](Entity::IDType entityID) noexcept { return erase(entityID); }));
+            endBatch();
+            return removed;
+        }
+
+        std::size_t removed = 0;
+        for (const Entity::IDType entityID : entityIDs)
+            if (m_set.contains(entityID))
+            {
+                notifyRemoving(entityID);
+                m_set.markErased(entityID);
+                notifyRemoved(entityID);
+                ++removed;
+            }
+
+        if (removed != 0)
+        {
+            m_set.compact([this](std::size_t from, std::size_t to) noexcept
+            {
+                forEachColumn([from, to]<std::size_t I>(auto& column, std::integral_constant<std::size_t, I>) noexcept { column[to] = std::move(column[from]); });
+            });
+            forEachColumn([this]<std::size_t I>(auto& column, std::integral_constant<std::size_t, I>) noexcept { column.resize(m_set.size()); });
+        }
+        endBatch();
+        return removed;
+    }
+
+    // Gather the members of an entity's component, the entity must have one
+    [[nodiscard]] Component load(Entity::IDType entityID) const noexcept
+    {
+        const std::size_t slot = m_set.index(entityID);
+        Component component{};
+        forEachColumn([&component, slot]<std::size_t I>(const auto& column, std::integral_constant<std::size_t, I>) noexcept
+        {
+            component.*std::get<I>(Members) = column[slot];
+        });
+        return component;
+    }
+
+    // Reserve room for a number of components in every column
+    void reserve(std::size_t capacity) noexcept
+    {
+        m_set.reserve(capacity);
+        forEachColumn([capacity]<std::size_t I>(auto& column, std::integral_constant<std::size_t, I>) noexcept { column.reserve(capacity); });
+    }
+
+    // Get the dense array of entity IDs, parallel to every column
+    [[nodiscard]] std::span<const Entity::IDType> entities() const noexcept { return m_set.entities(); }
+
+    // Get contiguous spans over every member column
+    [[nodiscard]] Spans columns() noexcept
+    {
+        return std::apply([](auto&... columns) noexcept { return Spans{ columns... }; }, m_columns);
+    }
+
+    // Get the number of components in the pool
+    [[nodiscard]] std::size_t size() const noexcept override { return m_set.size(); }
+
+    [[nodiscard]] PoolStats stats() const noexcept override
+    {
+        return std::apply([this](const auto&... columns) noexcept { return measure(m_set, std::get<0>(m_columns).capacity(), columns...); }, m_columns);
+    }
+
+    bool shrinkToFit(std::size_t& cursor, ShrinkBudget& budget) noexcept override
+    {
+        return std::apply([this, &cursor, &budget](auto&... columns) noexcept { return shrinkSteps(m_set, cursor, budget, columns...); }, m_columns);
+    }
+
+private:
+    // Call a function with every column and its member index
+    template<class Func>
+    void forEachColumn(Func&& func) noexcept
+    {
+        [this, &func]<std::size_t... I>(std::index_sequence<I...>) noexcept
+        {
+            (func(std::get<I>(m_columns), std::integral_constant<std::size_t, I>{}), ...);
+        }(std::make_index_sequence<MemberCount>{});
+    }
+
+    template<class Func>
+    void forEachColumn(Func&& func) const noexcept
+    {
+        [this, &func]<std::size_t... I>(std::index_sequence<I...>) noexcept
+        {
+            (func(std::get<I>(m_columns), std::integral_constant<std::size_t, I>{}), ...);
+        }(std::make_index_sequence<MemberCount>{});
+    }
+
+    SparseSet m_set{}; // Mapping from entity ID to dense slot
+    typename Columns::Vectors m_columns{}; // Dense column of every member
+};
+
+// Pool of a tag component, an empty type whose presence is the whole information, stores only the entity IDs
+// Every entity shares one instance of the tag, so views and queries over tags read no component memory
+template<TagComponentConcept Component>
+class TagPool final : public PoolBase
+{
+public:
+    explicit TagPool(std::pmr::memory_resource* resource = std::pmr::get_default_resource()) noexcept : m_set{ resource } {}
+
+    // Check if an entity has the tag
+    [[nodiscard]] bool contains(Entity::IDType entityID) const noexcept override
+    {
+        return m_set.contains(entityID);
+    }
+
+    // Remove the tag of an entity with swap-and-pop, returns false if the entity has none
+    bool remove(Entity::IDType entityID) noexcept override
+    {
+        return erase(entityID);
+    }
+
+    // Get a pointer to the shared tag instance if the entity has the tag, or nullptr if it has none
+    [[nodiscard]] Component* tryGet(Entity::IDType entityID) const noexcept
+    {
+        return m_set.contains(entityID) ? &s_instance : nullptr;
+    }
+
+    // Get the shared tag instance, the entity must have the tag
+    [[nodiscard]] Component& get([[maybe_unused]] Entity::IDType entityID) const noexcept
+    {
+        return s_instance;
+    }
+
+    // Add the tag to an entity, returns false if the entity already has it
+    bool emplace(Entity::IDType entityID, [[maybe_unused]] Component&& component) noexcept
+    {
+        if (!m_set.push(entityID))
+            return false;
+
+        notifyAdded(entityID);
+        return true;
+    }
+
+    // Remove the tag of an entity, returns false if the entity has none
+    bool erase(Entity::IDType entityID, RemovalOrder order = RemovalOrder::SwapAndPop) noexcept
+    {
+        if (!m_set.contains(entityID))
+            return false;
+
+        notifyRemoving(entityID);
+        if (order == RemovalOrder::Stable)
+            m_set.shiftErase(entityID);
+        else
+            m_set.swapAndPop(entityID);
+        notifyRemoved(entityID);
+        return true;
+    }
+
+    // Add the tag to entities, growing the entity array once and notifying the batch observers once
+    void insert(std::span<const Entity::IDType> entityIDs, std::span<Component> components, BulkPolicy policy) noexcept
+    {
+        beginBatch();
+        m_set.reserve(m_set.size() + entityIDs.size());
+        for (std::size_t i = 0; i < entityIDs.size(); ++i)
+            if (policy == BulkPolicy::AssumeUnique)
+            {
+                if (m_set.push(entityIDs[i]))
+                    notifyAdded(entityIDs[i]);
+            }
+            else
+                emplace(entityIDs[i], std::move(components[i]));
+        endBatch();
+    }
+
+    // Remove the tag from entities, stable removal compacts the entity array in a single pass, returns the number removed
+    std::size_t erase(std::span<const Entity::IDType> entityIDs, RemovalOrder order) noexcept
+    {
+        beginBatch();
+        if (order == RemovalOrder::SwapAndPop)
+        {
+            const std::size_t removed = static_cast<std::size_t>(std::ranges::count_if(entityIDs, [this](Entity::IDType entityID) noexcept { return erase(entityID); }));
+            endBatch();
+            return removed;
+        }
+
+        std::size_t removed = 0;
+        for (const Entity::IDType entityID : entityIDs)
+            if (m_set.contains(entityID))
+            {
+                notifyRemoving(entityID);
+                m_set.markErased(entityID);
+                notifyRemoved(entityID);
+                ++removed;
+            }
+        if (removed != 0)
+            m_set.compact([](std::size_t, std::size_t) noexcept {});
+        endBatch();
+        return removed;
+    }
+
+    // Reserve room for a number of entities
+    void reserve(std::size_t capacity) noexcept
+    {
+        m_set.reserve(capacity);
+    }
+
+    // Get the dense array of entity IDs with the tag
+    [[nodiscard]] std::span<const Entity::IDType> entities() const noexcept { return m_set.entities(); }
+
+    // Get the number of entities with the tag
+    [[nodiscard]] std::size_t size() const noexcept override { return m_set.size(); }
+
+    [[nodiscard]] PoolStats stats() const noexcept override
+    {
+        return measure(m_set, m_set.capacity());
+    }
+
+    bool shrinkToFit(std::size_t& cursor, ShrinkBudget& budget) noexcept override
+    {
+        return shrinkSteps(m_set, cursor, budget);
+    }
+
+private:
+    static inline Component s_instance{}; // Tag handed out for every entity, an empty type has no state to share
+
+    SparseSet m_set{}; // Entities with the tag
+};
+
+// Parent and child links of an entity in a hierarchy, maintained by its pool, only parent is read when the component is added
+struct Relationship final
+{
+    static constexpr Entity::IDType None = std::numeric_limits<Entity::IDType>::max(); // Marks a missing link
+
+    Entity::IDType parent{ None };
+    Entity::IDType firstChild{ None };
+    Entity::IDType previousSibling{ None };
+    Entity::IDType nextSibling{ None };
+    std::uint32_t depth{}; // Number of ancestors
+};
+
+// Pool of the relationships of a hierarchy, kept sorted by depth so every parent comes before all of its descendants
+// A sweep over the dense arrays visits the hierarchy in breadth-first level order, so propagating from parents to children is one linear pass
+// Every level is a contiguous range of slots, an entity changing depth moves one slot swap per level it crosses
+class HierarchyPool final : public PoolBase
+{
+public:
+    explicit HierarchyPool(std::pmr::memory_resource* resource = std::pmr::get_default_resource()) noexcept
+        : m_set{ resource }, m_relationships{ resource }, m_levelEnd{ resource } {}
+
+    // Check if an entity is part of the hierarchy
+    [[nodiscard]] bool contains(Entity::IDType entityID) const noexcept override
+    {
+        return m_set.contains(entityID);
+    }
+
+    // Remove an entity from the hierarchy, its children become roots, returns false if the entity is not part of it
+    bool remove(Entity::IDType entityID) noexcept override
+    {
+        return erase(entityID);
+    }
+
+    // Get a pointer to the relationship of an entity, or nullptr if the entity is not part of the hierarchy
+    [[nodiscard]] const Relationship* tryGet(Entity::IDType entityID) const noexcept
+    {
+        return m_set.contains(entityID) ? &m_relationships[m_set.index(entityID)] : nullptr;
+    }
+
+    // Get the relationship of an entity, the entity must be part of the hierarchy
+    [[nodiscard]] const Relationship& get(Entity::IDType entityID) const noexcept
+    {
+        return m_relationships[m_set.index(entityID)];
+    }
+
+    // Add an entity to the hierarchy under the parent of the relationship, returns false and adds nothing if it is already part of it
+    // or is its own parent
+    bool emplace(Entity::IDType entityID, Relationship&& relationship) noexcept
+    {
+        if (relationship.parent == entityID || !pushRoot(entityID))
+            return false;
+
+        notifyAdded(entityID);
+        return relationship.parent == Relationship::None || setParent(entityID, relationship.parent);
+    }
+
+    // Attach an entity to a new parent or make it a root with Relationship::None, missing entities are added as roots
+    // Its whole subtree moves to the new depths, returns false and changes nothing if the parent is the entity or one of its descendants
+    bool setParent(Entity::IDType entityID, Entity::IDType parentID) noexcept
+    {
+        if (!m_set.contains(entityID))
+            emplace(entityID, Relationship{});
+        if (parentID != Relationship::None && !m_set.contains(parentID))
+            emplace(parentID, Relationship{});
+
+        for (Entity::IDType ancestor = parentID; ancestor != Relationship::None; ancestor = get(ancestor).parent)
+            if (ancestor == entityID)
+                return false;
+
+        unlink(entityID);
+        std::uint32_t depth = 0;
+        if (parentID != Relationship::None)
+        {
+            link(entityID, parentID);
+            depth = get(parentID).depth + 1;
+        }
+        moveSubtree(entityID, depth);
+        return true;
+    }
+
+    // Remove an entity from the hierarchy, its children become roots, the order argument is ignored since the pool keeps its own order
+    bool erase(Entity::IDType entityID, [[maybe_unused]] RemovalOrder order = RemovalOrder::SwapAndPop) noexcept
+    {
+        if (!m_set.contains(entityID))
+            return false;
+
+        notifyRemoving(entityID);
+        while (get(entityID).firstChild != Relationship::None)
+            setParent(get(entityID).firstChild, Relationship::None);
+        unlink(entityID);
+
+        // Sink the entity to the deepest level, then it can be swapped with the last slot without breaking the order
+        moveToDepth(entityID, static_cast<std::uint32_t>(m_levelEnd.size() - 1));
+        swapSlots(m_set.index(entityID), m_relationships.size() - 1);
+        m_set.swapAndPop(entityID);
+        m_relationships.pop_back();
+        --m_levelEnd.back();
+        trimLevels();
+        notifyRemoved(entityID);
+        return true;
+    }
+
+    // Add entities to the hierarchy, notifying the batch observers once
+    void insert(std::span<const Entity::IDType> entityIDs, std::span<Relationship> relationships, [[maybe_unused]] BulkPolicy policy) noexcept
+    {
+        beginBatch();
+        reserve(m_set.size() + entityIDs.size());
+        for (std::size_t i = 0; i < entityIDs.size(); ++i)
+            emplace(entityIDs[i], std::move(relationships[i]));
+        endBatch();
+    }
+
+    // Remove entities from the hierarchy, returns the number removed
+    std::size_t erase(std::span<const Entity::IDType> entityIDs, [[maybe_unused]] RemovalOrder order) noexcept
+    {
+        beginBatch();
+        const std::size_t removed = static_cast<std::size_t>(std::ranges::count_if(entityIDs, [this](Entity::IDType entityID) noexcept { return erase(entityID); }));
+        endBatch();
+        return removed;
+    }
+
+    // Reserve room for a number of entities
+    void reserve(std::size_t capacity) noexcept
+    {
+        m_set.reserve(capacity);
+        m_relationships.reserve(capacity);
+    }
+
+    // Get the entities of the hierarchy, every parent comes before its children
+    [[nodiscard]] std::span<const Entity::IDType> entities() const noexcept { return m_set.entities(); }
+
+    // Get the relationships of the hierarchy, parallel to entities()
+    [[nodiscard]] std::span<const Relationship> relationships() const noexcept { return m_relationships; }
+
+    // Get the slots [begin, end) of the entities at a depth, empty past the deepest level
+    [[nodiscard]] std::pair<std::size_t, std::size_t> level(std::uint32_t depth) const noexcept
+    {
+        if (depth >= m_levelEnd.size())
+            return { m_relationships.size(), m_relationships.size() };
+        return { depth == 0 ? 0 : m_levelEnd[depth - 1], m_levelEnd[depth] };
+    }
+
+    // Get the number of entities in the hierarchy
+    [[nodiscard]] std::size_t size() const noexcept override { return m_relationships.size(); }
+
+    [[nodiscard]] PoolStats stats() const noexcept override
+    {
+        return measure(m_set, m_relationships.capacity(), m_relationships, m_levelEnd, m_stack);
+    }
+
+    bool shrinkToFit(std::size_t& cursor, ShrinkBudget& budget) noexcept override
+    {
+        return shrinkSteps(m_set, cursor, budget, m_relationships, m_levelEnd, m_stack);
+    }
+
+private:
+    [[nodiscard]] Relationship& at(Entity::IDType entityID) noexcept
+    {
+        return m_relationships[m_set.index(entityID)];
+    }
+
+    // Append an entity as a root, it enters the deepest level at the back and rises to the first, returns false if its index is taken
+    bool pushRoot(Entity::IDType entityID) noexcept
+    {
+        if (!m_set.push(entityID))
+            return false;
+
+        if (m_levelEnd.empty())
+            m_levelEnd.push_back(0);
+        m_relationships.push_back(Relationship{ .depth = static_cast<std::uint32_t>(m_levelEnd.size() - 1) });
+        ++m_levelEnd.back();
+        moveToDepth(entityID, 0);
+        return true;
+    }
+
+    // Make an entity the first child of a parent
+    void link(Entity::IDType entityID, Entity::IDType parentID) noexcept
+    {
+        Relationship& parent = at(parentID);
+        Relationship& child = at(entityID);
+        child.parent = parentID;
+        child.nextSibling = parent.firstChild;
+        if (parent.firstChild != Relationship::None)
+            at(parent.firstChild).previousSibling = entityID;
+        parent.firstChild = entityID;
+    }
+
+    // Detach an entity from its parent and siblings, its own children stay attached
+    void unlink(Entity::IDType entityID) noexcept
+    {
+        Relationship& child = at(entityID);
+        if (child.previousSibling != Relationship::None)
+            at(child.previousSibling).nextSibling = child.nextSibling;
+        else if (child.parent != Relationship::None)
+            at(child.parent).firstChild = child.nextSibling;
+        if (child.nextSibling != Relationship::None)
+            at(child.nextSibling).previousSibling = child.previousSibling;
+        child.parent = child.previousSibling = child.nextSibling = Relationship::None;
+    }
+
+    // Move an entity to a depth and every descendant to the depth below its parent
+    void moveSubtree(Entity::IDType entityID, std::uint32_t depth) noexcept
+    {
+        m_stack.push_back(entityID);
+        moveToDepth(entityID, depth);
+        while (!m_stack.empty())
+        {
+            const Entity::IDType parentID = m_stack.back();
+            m_stack.pop_back();
+            const std::uint32_t childDepth = get(parentID).depth + 1;
+            for (Entity::IDType childID = get(parentID).firstChild; childID != Relationship::None; childID = get(childID).nextSibling)
+            {
+                moveToDepth(childID, childDepth);
+                m_stack.push_back(childID);
+            }
+        }
+    }
+
+    // Move an entity between levels, swapping it across the boundary of every level in between
+    void moveToDepth(Entity::IDType entityID, std::uint32_t depth) noexcept
+    {
+        if (depth >= m_levelEnd.size())
+            m_levelEnd.resize(depth + 1, m_relationships.size());
+
+        std::size_t slot = m_set.index(entityID);
+        std::uint32_t current = m_relationships[slot].depth;
+        for (; current < depth; ++current)
+        {
+            const std::size_t last = --m_levelEnd[current];
+            swapSlots(slot, last);
+            slot = last;
+        }
+        for (; current > depth; --current)
+        {
+            const std::size_t first = m_levelEnd[current - 1]++;
+            swapSlots(slot, first);
+            slot = first;
+        }
+        m_relationships[slot].depth = depth;
+        trimLevels();
+    }
+
+    // Drop the empty levels past the deepest entity
+    void trimLevels() noexcept
+    {
+        while (!m_levelEnd.empty() && m_levelEnd.back() == (m_levelEnd.size() == 1 ? 0 : m_levelEnd[m_levelEnd.size() - 2]))
+            m_levelEnd.pop_back();
+    }
+
+    void swapSlots(std::size_t first, std::size_t second) noexcept
+    {
+        if (first == second)
+            return;
+
+        m_set.swapSlots(first, second);
+        std::swap(m_relationships[first], m_relationships[second]);
+    }
+
+    SparseSet m_set{}; // Mapping from entity ID to dense slot
+    std::pmr::vector<Relationship> m_relationships{};
+    std::pmr::vector<std::size_t> m_levelEnd{}; // End slot of every depth, the levels cover the dense arrays in order
+    std::vector<Entity::IDType> m_stack{}; // Entities whose children still have to move, kept to reuse its capacity
+};
+
+// Pool of components whose type is only described at runtime, for components registered by scripts or plugins
+// Keeps the same sparse set and dense layout as a ComponentPool, with components moved and destroyed through their ComponentInfo
+class ErasedPool final : public PoolBase
+{
+public:
+    explicit ErasedPool(const ComponentInfo& info, std::pmr::memory_resource* resource = std::pmr::get_default_resource()) noexcept
+        : m_info{ info }, m_stride{ std::max((info.size + info.alignment - 1) / info.alignment * info.alignment, info.alignment) }, m_set{ resource }, m_resource{ resource } {}
+
+    ErasedPool(const ErasedPool&) noexcept = delete;
+    ErasedPool(ErasedPool&&) noexcept = delete;
+    ErasedPool& operator=(const ErasedPool&) noexcept = delete;
+    ErasedPool& operator=(ErasedPool&&) noexcept = delete;
+
+    ~ErasedPool() noexcept override
+    {
+        for (std::size_t slot = 0; slot < size(); ++slot)
+            m_info.destroy(at(slot));
+        if (m_data != nullptr)
+            m_resource->deallocate(m_data, m_capacity * m_stride, m_info.alignment);
+    }
+
+    // Check if an entity has a component in the pool
+    [[nodiscard]] bool contains(Entity::IDType entityID) const noexcept override
+    {
+        return m_set.contains(entityID);
+    }
+
+    // Remove the component of an entity with swap-and-pop, returns false if the entity has none
+    bool remove(Entity::IDType entityID) noexcept override
+    {
+        if (!m_set.contains(entityID))
+            return false;
+
+        notifyRemoving(entityID);
+        const std::size_t slot = m_set.index(entityID);
+        const std::size_t last = size() - 1;
+        m_info.destroy(at(slot));
+        if (slot != last)
+        {
+            m_info.moveConstruct(at(slot), at(last));
+            m_info.destroy(at(last));
+        }
+        m_set.swapAndPop(entityID);
+        notifyRemoved(entityID);
+        return true;
+    }
+
+    // Get the number of components in the pool
+    [[nodiscard]] std::size_t size() const noexcept override { return m_set.size(); }
+
+    [[nodiscard]] PoolStats stats() const noexcept override
+    {
+        return measureBytes(m_set, m_capacity, m_capacity * m_stride, size() * m_stride);
+    }
+
+    bool shrinkToFit(std::size_t& cursor, ShrinkBudget& budget) noexcept override
+    {
+        // Step 0 reallocates the component block to fit, the remaining steps are the sparse set ones
+        if (cursor == 0)
+        {
+            const bool shrink = m_capacity > 2 * size();
+            if (budget.spent() || !budget.take(shrink ? size() * m_stride : 0))
+                return false;
+            if (shrink)
+                reallocate(size());
+            ++cursor;
+        }
+
+        std::size_t setCursor = cursor - 1;
+        const bool done = shrinkSteps(m_set, setCursor, budget);
+        cursor = setCursor + 1;
+        return done;
+    }
+
+    [[nodiscard]] ComponentBlock block() noexcept override
+    {
+        return ComponentBlock{ m_set.entities(), m_data, m_stride };
+    }
+
+    [[nodiscard]] void* tryGetRaw(Entity::IDType entityID) noexcept override
+    {
+        return m_set.contains(entityID) ? at(m_set.index(entityID)) : nullptr;
+    }
+
+    bool emplaceRaw(Entity::IDType entityID, void* source) noexcept override
+    {
+        if (size() == m_capacity)
+            reallocate(std::max(m_capacity * 2, std::size_t{ 8 }));
+        if (!m_set.push(entityID))
+            return false;
+
+        m_info.moveConstruct(at(size() - 1), source);
+        notifyAdded(entityID);
+        return true;
+    }
+
+    // Get the description of the component type
+    [[nodiscard]] const ComponentInfo& info() const noexcept { return m_info; }
+
+    // Get the dense array of entity IDs, parallel to the component block
+    [[nodiscard]] std::span<const Entity::IDType> entities() const noexcept { return m_set.entities(); }
+
+private:
+    [[nodiscard]] std::byte* at(std::size_t slot) const noexcept { return m_data + slot * m_stride; }
+
+    // Move the components into a block with room for a number of them
+    void reallocate(std::size_t capacity) noexcept
+    {
+        std::byte* data = capacity != 0 ? static_cast<std::byte*>(m_resource->allocate(capacity * m_stride, m_info.alignment)) : nullptr;
+        for (std::size_t slot = 0; slot < size(); ++slot)
+        {
+            m_info.moveConstruct(data + slot * m_stride, at(slot));
+            m_info.destroy(at(slot));
+        }
+        if (m_data != nullptr)
+            m_resource->deallocate(m_data, m_capacity * m_stride, m_info.alignment);
+        m_data = data;
+        m_capacity = capacity;
+    }
+
+    ComponentInfo m_info{};
+    std::size_t m_stride{}; // Distance between two components, the size rounded up to the alignment
+    SparseSet m_set{}; // Mapping from entity ID to dense slot
+    std::pmr::memory_resource* m_resource{};
+    std::byte* m_data{}; // Dense block of components
+    std::size_t m_capacity{}; // Number of components the block has room for
+};
+
+// Helper to select the pool type of a component, structure-of-arrays components get a SoAPool, tags a TagPool and relationships a HierarchyPool
+template<ComponentConcept Component>
+struct PoolTypeOf
+{
+    using type = ComponentPool<Component>;
+};
+
+template<SoAComponentConcept Component>
+struct PoolTypeOf<Component>
+{
+    using type = SoAPool<Component>;
+};
+
+template<TagComponentConcept Component>
+struct PoolTypeOf<Component>
+{
+    using type = TagPool<Component>;
+};
+
+template<>
+struct PoolTypeOf<Relationship>
+{
+    using type = HierarchyPool;
+};
+
+template<ComponentConcept Component>
+using PoolType = typename PoolTypeOf<Component>::type;
+
+// Factory creating the pool of a C++ component type, so the functions taking a type ID can create a pool no typed call created yet
+struct PoolFactory final
+{
+    const ComponentTypeID* id{}; // Read once static initialization is done, since IDs are assigned in no specified order
+    std::unique_ptr<PoolBase> (*create)(std::pmr::memory_resource* resource) noexcept {};
+};
+
+// Get the pool factories of the C++ component types the program uses through a world
+[[nodiscard]] inline std::vector<PoolFactory>& poolFactories() noexcept
+{
+    static std::vector<PoolFactory> factories{};
+    return factories;
+}
+
+// Register the pool factory of a component type during dynamic initialization, instantiated by the world for every type it stores
+template<ComponentConcept Component>
+inline const bool PoolFactoryRegistered = (poolFactories().push_back(PoolFactory{ &ComponentTypeIDOf<Component>,
+    [](std::pmr::memory_resource* resource) noexcept -> std::unique_ptr<PoolBase> { return std::make_unique<PoolType<Component>>(resource); } }), true);
+
+// Concept to ensure a component is stored in a plain ComponentPool, with one dense component per entity
+template<class Component>
+concept PooledComponentConcept = ComponentConcept<Component> && std::same_as<PoolType<Component>, ComponentPool<Component>>;
+
+// Concept to ensure a type is a valid system, its component type has to live in a plain ComponentPool
+template<class System, class... Args>
+concept SystemConcept =
+    requires(System system, typename System::ComponentType& component, Args&&... args)
+    {
+        typename System::ComponentType; // System must define a ComponentType
+        { system(component, std::forward<Args>(args)...) } noexcept; // System must be callable with a component and arguments
+    } && std::default_initializable<System> && PooledComponentConcept<typename System::ComponentType>;
+
+// View over the entities that have all of the given component types, iterates the smallest pool and probes the others
+template<ComponentConcept... Components>
+class View final
+{
+public:
+    // Iterator yielding the entity ID and references to its components
+    class Iterator final
+    {
+    public:
+        using value_type = std::tuple<Entity::IDType, Components&...>;
+        using difference_type = std::ptrdiff_t;
+
+        Iterator() noexcept = default;
+        Iterator(const View* view, std::size_t slot) noexcept : m_view{ view }, m_slot{ slot } { skipUnmatched(); }
+
+        [[nodiscard]] value_type operator*() const noexcept
+        {
+            const Entity::IDType entityID = m_view->m_entities[m_slot];
+            return value_type{ entityID, std::get<PoolType<Components>*>(m_view->m_pools)->get(entityID)... };
+        }
+
+        Iterator& operator++() noexcept
+        {
+            ++m_slot;
+            skipUnmatched();
+            return *this;
+        }
+
+        Iterator operator++(int) noexcept
+        {
+            Iterator previous = *this;
+            ++*this;
+            return previous;
+        }
+
+        [[nodiscard]] bool operator==(const Iterator& other) const noexcept { return m_slot == other.m_slot; }
+
+    private:
+        // Advance to the next entity that has every component of the view
+        void skipUnmatched() noexcept
+        {
+            while (m_slot < m_view->m_entities.size() && !m_view->containsAll(m_view->m_entities[m_slot]))
+                ++m_slot;
+        }
+
+        const View* m_view{};
+        std::size_t m_slot{};
+    };
+
+    explicit View(PoolType<Components>&... pools) noexcept : m_pools{ &pools... }
+    {
+        m_entities = std::get<0>(m_pools)->entities();
+        ((m_entities = pools.size() < m_entities.size() ? pools.entities() : m_entities), ...);
+    }
+
+    [[nodiscard]] Iterator begin() const noexcept { return Iterator{ this, 0 }; }
+    [[nodiscard]] Iterator end() const noexcept { return Iterator{ this, m_entities.size() }; }
+
+    // Get the number of entities driving the iteration, an upper bound of the entities in the view
+    [[nodiscard]] std::size_t sizeHint() const noexcept { return m_entities.size(); }
+
+    // Call a function with the entity ID and the components of every entity in the view
+    template<class Func> requires std::is_nothrow_invocable_v<Func&, Entity::IDType, Components&...>
+    void each(Func&& func) const noexcept
+    {
+        each(0, m_entities.size(), func);
+    }
+
+    // Call a function for every entity in the view within the slots [begin, end) of the driving pool
+    template<class Func> requires std::is_nothrow_invocable_v<Func&, Entity::IDType, Components&...>
+    void each(std::size_t begin, std::size_t end, Func&& func) const noexcept
+    {
+        for (const Entity::IDType entityID : m_entities.subspan(begin, end - begin))
+            if (containsAll(entityID))
+                func(entityID, std::get<PoolType<Components>*>(m_pools)->get(entityID)...);
+    }
+
+private:
+    // Check if an entity has every component of the view
+    [[nodiscard]] bool containsAll(Entity::IDType entityID) const noexcept
+    {
+        return (std::get<PoolType<Components>*>(m_pools)->contains(entityID) && ...);
+    }
+
+    std::tuple<PoolType<Components>*...> m_pools{}; // Pools joined by the view
+    std::span<const Entity::IDType> m_entities{}; // Entities of the smallest pool, driving the iteration
+};
+
+// Marks the component types an entity must not have to match a query
+template<ComponentConcept... Components>
+struct Exclude final {};
+
+// Split the arguments of a query into the included component types and the excluded ones
+template<class Included, class Excluded, class... Args>
+struct QueryArgs
+{
+    using IncludedTypes = Included;
+    using ExcludedTypes = Excluded;
+};
+
+template<class... Included, class... Excluded, class... More, class... Args>
+struct QueryArgs<std::tuple<Included...>, Exclude<Excluded...>, Exclude<More...>, Args...> : QueryArgs<std::tuple<Included...>, Exclude<Excluded..., More...>, Args...> {};
+
+template<class... Included, class... Excluded, class Arg, class... Args>
+struct QueryArgs<std::tuple<Included...>, Exclude<Excluded...>, Arg, Args...> : QueryArgs<std::tuple<Included..., Arg>, Exclude<Excluded...>, Args...> {};
+
+template<class Included, class Excluded>
+class CachedQuery;
+
+// Persistent query caching the entities that have every included component and none of the excluded ones
+// The cache is kept up to date by the add and remove observers of the pools, so iteration never rejects an entity
+// A query must be destroyed before its world is cleared or destroyed
+template<ComponentConcept... Components, ComponentConcept... Excluded>
+class CachedQuery<std::tuple<Components...>, Exclude<Excluded...>> final
+{
+public:
+    CachedQuery(PoolType<Components>&... pools, PoolType<Excluded>&... excludedPools) noexcept : m_pools{ &pools... }, m_excludedPools{ &excludedPools... }
+    {
+        // Fill the cache once from the smallest included pool, every later change arrives through the observers
+        std::span<const Entity::IDType> entities = std::get<0>(m_pools)->entities();
+        ((entities = pools.size() < entities.size() ? pools.entities() : entities), ...);
+        for (const Entity::IDType entityID : entities)
+            tryInsert(entityID);
+
+        (m_observers.push_back({ &pools, pools.connectOnAdd([this](Entity::IDType entityID) noexcept { tryInsert(entityID); }) }), ...);
+        (m_observers.push_back({ &pools, pools.connectOnRemove([this](Entity::IDType entityID) noexcept { erase(entityID); }) }), ...);
+        (m_observers.push_back({ &excludedPools, excludedPools.connectOnAdd([this](Entity::IDType entityID) noexcept { erase(entityID); }) }), ...);
+        // An excluded component is still there when its remove observer runs, so recheck once it is gone
+        (m_observers.push_back({ &excludedPools, excludedPools.connectOnRemoveBatch([this](std::span<const Entity::IDType> entityIDs) noexcept
+        {
+            for (const Entity::IDType entityID : entityIDs)
+                tryInsert(entityID);
+        }) }), ...);
+    }
+
+    CachedQuery(const CachedQuery&) = delete;
+    CachedQuery(CachedQuery&&) = delete;
+    CachedQuery& operator=(const CachedQuery&) = delete;
+    CachedQuery& operator=(CachedQuery&&) = delete;
+
+    ~CachedQuery() noexcept
+    {
+        for (const auto& [pool, id] : m_observers)
+            pool->disconnect(id);
+    }
+
+    // Check if an entity matches the query
+    [[nodiscard]] bool contains(Entity::IDType entityID) const noexcept
+    {
+        return m_matches.contains(entityID);
+    }
+
+    // Get the matching entities, the order is unspecified
+    [[nodiscard]] std::span<const Entity::IDType> entities() const noexcept
+    {
+        return m_matches.entities();
+    }
+
+    // Get the number of matching entities
+    [[nodiscard]] std::size_t size() const noexcept
+    {
+        return m_matches.size();
+    }
+
+    // Call a function with the entity ID and the components of every matching entity
+    template<class Func> requires std::is_nothrow_invocable_v<Func&, Entity::IDType, Components&...>
+    void each(Func&& func) const noexcept
+    {
+        each(0, m_matches.size(), func);
+    }
+
+    // Call a function for the matching entities within the slots [begin, end) of the cache
+    template<class Func> requires std::is_nothrow_invocable_v<Func&, Entity::IDType, Components&...>
+    void each(std::size_t begin, std::size_t end, Func&& func) const noexcept
+    {
+        for (const Entity::IDType entityID : m_matches.entities().subspan(begin, end - begin))
+            func(entityID, std::get<PoolType<Components>*>(m_pools)->get(entityID)...);
+    }
+
+private:
+    // Add an entity to the cache if it matches and isn't cached yet
+    void tryInsert(Entity::IDType entityID) noexcept
+    {
+        if (!m_matches.contains(entityID)
+            && (std::get<PoolType<Components>*>(m_pools)->contains(entityID) && ...)
+            && !(std::get<PoolType<Excluded>*>(m_excludedPools)->contains(entityID) || ...))
+            m_matches.push(entityID);
+    }
+
+    // Remove an entity from the cache if it is cached
+    void erase(Entity::IDType entityID) noexcept
+    {
+        if (m_matches.contains(entityID))
+            m_matches.swapAndPop(entityID);
+    }
+
+    std::tuple<PoolType<Components>*...> m_pools{}; // Pools of the included components
+    std::tuple<PoolType<Excluded>*...> m_excludedPools{}; // Pools of the excluded components
+    std::vector<std::pair<PoolBase*, ObserverID>> m_observers{}; // Observers connected by the query, disconnected on destruction
+    SparseSet m_matches{}; // Entities matching the query
+};
+
+// Cached query over the given component types, a trailing Exclude<...> lists the component types that must be absent
+template<class... Args>
+using Query = CachedQuery<typename QueryArgs<std::tuple<>, Exclude<>, Args...>::IncludedTypes, typename QueryArgs<std::tuple<>, Exclude<>, Args...>::ExcludedTypes>;
+
+// Group owning the pools of the given component types, keeps them co-sorted so the entities with every component share a prefix
+// The first size() slots of every owned pool hold the same entities in the same order, so iterating the group zips dense arrays
+// A pool can be owned by a single group, and the group must be destroyed before its world is cleared or destroyed
+template<PooledComponentConcept... Components> requires (sizeof...(Components) > 1)
+class Group final
+{
+public:
+    explicit Group(ComponentPool<Components>&... pools) noexcept : m_pools{ &pools... }
+    {
+        // Walk the smallest pool once, every earlier slot is already visited so swapping into the prefix never skips an entity
+        PoolBase* smallest = std::get<0>(m_pools);
+        ((smallest = pools.size() < smallest->size() ? &pools : smallest), ...);
+        ((&pools == smallest ? fill(pools) : void()), ...);
+
+        (m_observers.push_back({ &pools, pools.connectOnAdd([this](Entity::IDType entityID) noexcept { tryInsert(entityID); }) }), ...);
+        (m_observers.push_back({ &pools, pools.connectOnRemove([this](Entity::IDType entityID) noexcept { erase(entityID); }) }), ...);
+    }
+
+    Group(const Group&) = delete;
+    Group(Group&&) = delete;
+    Group& operator=(const Group&) = delete;
+    Group& operator=(Group&&) = delete;
+
+    ~Group() noexcept
+    {
+        for (const auto& [pool, id] : m_observers)
+            pool->disconnect(id);
+    }
+
+    // Check if an entity has every component of the group
+    [[nodiscard]] bool contains(Entity::IDType entityID) const noexcept
+    {
+        const ComponentPool<std::tuple_element_t<0, std::tuple<Components...>>>& pool = *std::get<0>(m_pools);
+        return pool.contains(entityID) && pool.index(entityID) < m_size;
+    }
+
+    // Get the entities of the group, parallel to every span returned by components()
+    [[nodiscard]] std::span<const Entity::IDType> entities() const noexcept
+    {
+        return std::get<0>(m_pools)->entities().first(m_size);
+    }
+
+    // Get the components of one type of the group, parallel to entities()
+    template<ComponentConcept Component>
+    [[nodiscard]] std::span<Component> components() const noexcept
+    {
+        return std::get<ComponentPool<Component>*>(m_pools)->components().first(m_size);
+    }
+
+    // Get the number of entities with every component of the group
+    [[nodiscard]] std::size_t size() const noexcept
+    {
+        return m_size;
+    }
+
+    // Call a function with the entity ID and the components of every entity in the group
+    template<class Func> requires std::is_nothrow_invocable_v<Func&, Entity::IDType, Components&...>
+    void each(Func&& func) const noexcept
+    {
+        each(0, m_size, func);
+    }
+
+    // Call a function for the entities of the group within the slots [begin, end)
+    template<class Func> requires std::is_nothrow_invocable_v<Func&, Entity::IDType, Components&...>
+    void each(std::size_t begin, std::size_t end, Func&& func) const noexcept
+    {
+        const std::span<const Entity::IDType> entityIDs = entities();
+        const std::tuple<std::span<Components>...> columns{ components<Components>()... };
+        for (std::size_t slot = begin; slot < end; ++slot)
+            func(entityIDs[slot], std::get<std::span<Components>>(columns)[slot]...);
+    }
+
+private:
+    // Move every entity of a pool that has all the components into the prefix
+    template<ComponentConcept Component>
+    void fill(ComponentPool<Component>& pool) noexcept
+    {
+        for (std::size_t slot = 0; slot < pool.size(); ++slot)
+            tryInsert(pool.entities()[slot]);
+    }
+
+    // Move an entity into the prefix of every owned pool once it has all the components
+    void tryInsert(Entity::IDType entityID) noexcept
+    {
+        if ((std::get<ComponentPool<Components>*>(m_pools)->contains(entityID) && ...) && !contains(entityID))
+        {
+            (std::get<ComponentPool<Components>*>(m_pools)->swapSlots(std::get<ComponentPool<Components>*>(m_pools)->index(entityID), m_size), ...);
+            ++m_size;
+        }
+    }
+
+    // Move an entity out of the prefix of every owned pool before it loses one of the components
+    void erase(Entity::IDType entityID) noexcept
+    {
+        if (contains(entityID))
+        {
+            --m_size;
+            (std::get<ComponentPool<Components>*>(m_pools)->swapSlots(std::get<ComponentPool<Components>*>(m_pools)->index(entityID), m_size), ...);
+        }
+    }
+
+    std::tuple<ComponentPool<Components>*...> m_pools{}; // Pools owned by the group
+    std::vector<std::pair<PoolBase*, ObserverID>> m_observers{}; // Observers connected by the group, disconnected on destruction
+    std::size_t m_size{}; // Length of the shared prefix
+};
+
+// Concept for components holding a 2D position in x and y members, which a spatial grid can index
+template<class Component>
+concept PlanarComponentConcept = PooledComponentConcept<Component> && requires(const Component& component)
+{
+    { component.x } -> std::convertible_to<float>;
+    { component.y } -> std::convertible_to<float>;
+};
+
+// Uniform grid over the positions of a component type, answers range and nearest-neighbour queries without scanning the pool
+// Adds and removes reach the grid through the pool observers as they happen, moved components are picked up by update from change tracking
+// Query results go into a buffer owned by the grid, the returned span stays valid until the next query
+template<PlanarComponentConcept Component>
+class SpatialGrid final
+{
+public:
+    SpatialGrid(ComponentPool<Component>& pool, const Tick& tick, float cellSize) noexcept
+        : m_pool{ pool }, m_tick{ tick }, m_cellSize{ cellSize }
+    {
+        for (const Entity::IDType entityID : pool.entities())
+            insert(entityID);
+        m_syncedTick = m_tick - 1;
+
+        m_observers[0] = pool.connectOnAdd([this](Entity::IDType entityID) noexcept { insert(entityID); });
+        m_observers[1] = pool.connectOnRemove([this](Entity::IDType entityID) noexcept { erase(entityID); });
+    }
+
+    SpatialGrid(const SpatialGrid&) = delete;
+    SpatialGrid(SpatialGrid&&) = delete;
+    SpatialGrid& operator=(const SpatialGrid&) = delete;
+    SpatialGrid& operator=(SpatialGrid&&) = delete;
+
+    ~SpatialGrid() noexcept
+    {
+        for (const ObserverID id : m_observers)
+            m_pool.disconnect(id);
+    }
+
+    // Move the components changed since the previous update to their new cells
+    // Every change tick of the pool is read on each call, only the components stamped since the previous update are looked at
+    // Components changed at the current tick are looked at again by the next update, since they may still change
+    void update() noexcept
+    {
+        const std::span<const Tick> ticks = m_pool.changeTicks();
+        const std::span<const Entity::IDType> entities = m_pool.entities();
+        const std::span<const Component> components = std::as_const(m_pool).components();
+        for (std::size_t slot = 0; slot < ticks.size(); ++slot)
+            if (ticks[slot] > m_syncedTick)
+                move(entities[slot], components[slot]);
+        m_syncedTick = m_tick - 1;
+    }
+
+    // Get the entities positioned within a radius of a point, as of the last update
+    [[nodiscard]] std::span<const Entity::IDType> queryRadius(float x, float y, float radius) noexcept
+    {
+        m_results.clear();
+        const float squaredRadius = radius * radius;
+        forEachCell(x - radius, y - radius, x + radius, y + radius, [this, x, y, squaredRadius](const std::vector<Item>& cell) noexcept
+        {
+            for (const Item& item : cell)
+                if ((item.x - x) * (item.x - x) + (item.y - y) * (item.y - y) <= squaredRadius)
+                    m_results.push_back(item.entityID);
+        });
+        return m_results;
+    }
+
+    // Get the entities positioned inside an axis-aligned box, bounds included, as of the last update
+    [[nodiscard]] std::span<const Entity::IDType> queryBox(float minX, float minY, float maxX, float maxY) noexcept
+    {
+        m_results.clear();
+        forEachCell(minX, minY, maxX, maxY, [this, minX, minY, maxX, maxY](const std::vector<Item>& cell) noexcept
+        {
+            for (const Item& item : cell)
+                if (item.x >= minX && item.x <= maxX && item.y >= minY && item.y <= maxY)
+                    m_results.push_back(item.entityID);
+        });
+        return m_results;
+    }
+
+    // Get up to count entities nearest to a point, closest first, as of the last update
+    // Rings of cells are searched outwards until no unvisited cell can hold anything closer
+    [[nodiscard]] std::span<const Entity::IDType> nearest(float x, float y, std::size_t count) noexcept
+    {
+        m_results.clear();
+        m_candidates.clear();
+        if (count == 0 || m_cells.empty())
+            return m_results;
+
+        const auto collect = [this, x, y](const std::vector<Item>& cell) noexcept
+        {
+            for (const Item& item : cell)
+                m_candidates.emplace_back((item.x - x) * (item.x - x) + (item.y - y) * (item.y - y), item.entityID);
+        };
+
+        const std::int64_t centerX = coordinateOf(x);
+        const std::int64_t centerY = coordinateOf(y);
+        const std::int64_t lastRing = std::max({ centerX - m_min[0], m_max[0] - centerX, centerY - m_min[1], m_max[1] - centerY });
+        std::size_t visitedCells = 0;
+        for (std::int64_t ring = 0; ring <= lastRing; ++ring)
+        {
+            // Far from every component walking the rings costs more than looking at every cell once
+            visitedCells += ring == 0 ? 1 : static_cast<std::size_t>(8 * ring);
+            if (visitedCells > m_cells.size())
+            {
+                m_candidates.clear();
+                for (const auto& [key, cell] : m_cells)
+                    collect(cell);
+                break;
+            }
+
+            for (std::int64_t offset = -ring; offset <= ring; ++offset)
+            {
+                visit(centerX + offset, centerY - ring, collect);
+                if (ring != 0)
+                    visit(centerX + offset, centerY + ring, collect);
+            }
+            for (std::int64_t offset = -ring + 1; offset <= ring - 1; ++offset)
+            {
+                visit(centerX - ring, centerY + offset, collect);
+                visit(centerX + ring, centerY + offset, collect);
+            }
+
+            // Every cell of the next ring is at least ring cells away from the point
+            if (m_candidates.size() >= count)
+            {
+                std::ranges::nth_element(m_candidates, m_candidates.begin() + static_cast<std::ptrdiff_t>(count - 1));
+                const float reach = static_cast<float>(ring) * m_cellSize;
+                if (m_candidates[count - 1].first <= reach * reach)
+                    break;
+            }
+        }
+
+        count = std::min(count, m_candidates.size());
+        std::ranges::partial_sort(m_candidates, m_candidates.begin() + static_cast<std::ptrdiff_t>(count));
+        for (std::size_t i = 0; i < count; ++i)
+            m_results.push_back(m_candidates[i].second);
+        return m_results;
+    }
+
+    // Get the number of indexed entities
+    [[nodiscard]] std::size_t size() const noexcept { return m_locations.size(); }
+
+private:
+    using CellKey = std::uint64_t;
+
+    // Entity and position stored in a cell, so queries never touch the pool
+    struct Item final
+    {
+        Entity::IDType entityID{};
+        float x{};
+        float y{};
+    };
+
+    // Cell an entity is stored in and its slot there
+    struct Location final
+    {
+        CellKey cell{};
+        std::uint32_t slot{};
+    };
+
+    // Get the cell coordinate of a position along one axis
+    // Clamped to the 32 bit range a cell key holds before the cast, so infinite, huge and NaN positions land in an edge cell
+    [[nodiscard]] std::int64_t coordinateOf(float position) const noexcept
+    {
+        static constexpr double Lowest = std::numeric_limits<std::int32_t>::min();
+        static constexpr double Highest = std::numeric_limits<std::int32_t>::max();
+        const double cell = std::floor(static_cast<double>(position) / static_cast<double>(m_cellSize));
+        if (!(cell >= Lowest))
+            return std::numeric_limits<std::int32_t>::min();
+        return cell > Highest ? std::numeric_limits<std::int32_t>::max() : static_cast<std::int64_t>(cell);
+    }
+
+    [[nodiscard]] static CellKey keyOf(std::int64_t cellX, std::int64_t cellY) noexcept
+    {
+        return (static_cast<CellKey>(static_cast<std::uint32_t>(cellX)) << 32) | static_cast<std::uint32_t>(cellY);
+    }
+
+    // Call a function with a cell if it holds anything
+    template<class Func>
+    void visit(std::int64_t cellX, std::int64_t cellY, Func& func) const noexcept
+    {
+        if (cellX < m_min[0] || cellX > m_max[0] || cellY < m_min[1] || cellY > m_max[1])
+            return;
+        if (const auto cell = m_cells.find(keyOf(cellX, cellY)); cell != m_cells.end())
+            func(cell->second);
+    }
+
+    // Call a function with every non-empty cell overlapping a box, or with every cell if the box spans more cells than exist
+    template<class Func>
+    void forEachCell(float minX, float minY, float maxX, float maxY, Func func) const noexcept
+    {
+        if (m_cells.empty())
+            return;
+
+        const std::int64_t firstX = std::max(coordinateOf(minX), m_min[0]);
+        const std::int64_t lastX = std::min(coordinateOf(maxX), m_max[0]);
+        const std::int64_t firstY = std::max(coordinateOf(minY), m_min[1]);
+        const std::int64_t lastY = std::min(coordinateOf(maxY), m_max[1]);
+        if (firstX > lastX || firstY > lastY)
+            return;
+
+        if (static_cast<std::uint64_t>(lastX - firstX + 1) * static_cast<std::uint64_t>(lastY - firstY + 1) > m_cells.size())
+        {
+            for (const auto& [key, cell] : m_cells)
+                func(cell);
+            return;
+        }
+
+        for (std::int64_t cellX = firstX; cellX <= lastX; ++cellX)
+            for (std::int64_t cellY = firstY; cellY <= lastY; ++cellY)
+                visit(cellX, cellY, func);
+    }
+
+    // Put an entity of the pool into the cell of its position
+    void insert(Entity::IDType entityID) noexcept
+    {
+        if (m_locations.contains(entityID))
+            return;
+
+        const Component& component = *std::as_const(m_pool).tryGet(entityID);
+        const float x = static_cast<float>(component.x);
+        const float y = static_cast<float>(component.y);
+        const std::int64_t cellX = coordinateOf(x);
+        const std::int64_t cellY = coordinateOf(y);
+        std::vector<Item>& cell = m_cells[keyOf(cellX, cellY)];
+        m_locations.emplace(entityID, Location{ keyOf(cellX, cellY), static_cast<std::uint32_t>(cell.size()) });
+        cell.push_back(Item{ entityID, x, y });
+        m_min = { std::min(m_min[0], cellX), std::min(m_min[1], cellY) };
+        m_max = { std::max(m_max[0], cellX), std::max(m_max[1], cellY) };
+    }
+
+    // Take an entity out of its cell, the last entity of the cell moves into its slot
+    void erase(Entity::IDType entityID) noexcept
+    {
+        const Location* location = m_locations.tryGet(entityID);
+        if (location == nullptr)
+            return;
+
+        const auto cell = m_cells.find(location->cell);
+        const std::uint32_t slot = location->slot;
+        if (slot != cell->second.size() - 1)
+        {
+            cell->second[slot] = cell->second.back();
+            m_locations.get(cell->second[slot].entityID).slot = slot;
+        }
+        cell->second.pop_back();
+        if (cell->second.empty())
+            m_cells.erase(cell);
+        m_locations.erase(entityID);
+    }
+
+    // Store the new position of an entity, moving it to another cell if it left its own
+    void move(Entity::IDType entityID, const Component& component) noexcept
+    {
+        const Location& location = m_locations.get(entityID);
+        if (location.cell != keyOf(coordinateOf(static_cast<float>(component.x)), coordinateOf(static_cast<float>(component.y))))
+        {
+            erase(entityID);
+            insert(entityID);
+            return;
+        }
+
+        Item& item = m_cells.find(location.cell)->second[location.slot];
+        item.x = static_cast<float>(component.x);
+        item.y = static_cast<float>(component.y);
+    }
+
+    ComponentPool<Component>& m_pool;
+    const Tick& m_tick; // Current tick of the owning world
+    float m_cellSize{};
+    Tick m_syncedTick{}; // Components stamped after this tick may have moved since the previous update
+    std::unordered_map<CellKey, std::vector<Item>> m_cells{}; // Non-empty cells by packed coordinates
+    ComponentPool<Location> m_locations{}; // Cell and slot of every indexed entity
+    std::array<std::int64_t, 2> m_min{ std::numeric_limits<std::int64_t>::max(), std::numeric_limits<std::int64_t>::max() }; // Lowest cell coordinates ever used
+    std::array<std::int64_t, 2> m_max{ std::numeric_limits<std::int64_t>::min(), std::numeric_limits<std::int64_t>::min() }; // Highest cell coordinates ever used
+    std::vector<std::pair<float, Entity::IDType>> m_candidates{}; // Squared distances and entities gathered by nearest
+    std::vector<Entity::IDType> m_results{};
+    std::array<ObserverID, 2> m_observers{};
+};
+
+// Concept for components small and plain enough to be copied word by word into slots other threads read without locking
+template<class Component>
+concept SeqLockComponentConcept = PooledComponentConcept<Component> && std::is_trivially_copyable_v<Component> && sizeof(Component) <= 64;
+
+// How a pool is shared with threads that don't run the world
+enum class AccessPolicy : std::uint8_t
+{
+    SeqLock, // Per-entity reads from any thread, retried when they overlap a publish
+    DoubleBuffered, // Whole-pool frame of the previous tick, for the world thread
+    TripleBuffered, // Whole-pool frame of the latest tick, for one reader thread
+};
+
+// Copy of a pool other threads can read while the world runs, brought up to date by the world thread at the end of every tick
+class SharedPoolBase
+{
+public:
+    virtual ~SharedPoolBase() noexcept = default;
+
+    // Get the access policy the copy implements
+    [[nodiscard]] virtual AccessPolicy policy() const noexcept = 0;
+
+    // Copy every component added or changed after the previous publish and drop the removed ones, then remember the tick
+    virtual void publish(Tick tick) noexcept = 0;
+};
+
+// Seqlock access policy of a pool, every component is mirrored into a slot addressed by entity index
+// Readers on any thread copy a slot out and retry if a publish wrote it meanwhile, the world thread never waits for them
+// The slots live in pages that are never freed while the mirror exists, so reads never touch memory the pool reallocates
+template<SeqLockComponentConcept Component>
+class SeqLockPool final : public SharedPoolBase
+{
+public:
+    static constexpr AccessPolicy Policy = AccessPolicy::SeqLock;
+
+    explicit SeqLockPool(ComponentPool<Component>& pool) noexcept : m_pool{ pool }
+    {
+        m_observer = m_pool.connectOnRemove([this](Entity::IDType entityID) noexcept { m_removed.push_back(entityID); });
+    }
+
+    SeqLockPool(const SeqLockPool&) = delete;
+    SeqLockPool& operator=(const SeqLockPool&) = delete;
+
+    ~SeqLockPool() noexcept override
+    {
+        m_pool.disconnect(m_observer);
+    }
+
+    // Read the component of an entity as of the last publish from any thread, or an empty optional if it had none
+    [[nodiscard]] std::optional<Component> read(Entity::IDType entityID) const noexcept
+    {
+        const Page* page = m_pages[Entity::indexOf(entityID) / PageSize].load(std::memory_order_acquire);
+        if (page == nullptr)
+            return std::nullopt;
+
+        const Slot& slot = page->slots[Entity::indexOf(entityID) % PageSize];
+        std::array<Word, WordCount> words{};
+        while (true)
+        {
+            const std::uint32_t sequence = slot.sequence.load(std::memory_order_acquire);
+            if (sequence % 2 != 0)
+                continue;
+
+            const Entity::IDType stored = slot.entityID.load(std::memory_order_relaxed);
+            const bool present = slot.present.load(std::memory_order_relaxed);
+            for (std::size_t i = 0; i < WordCount; ++i)
+                words[i] = slot.words[i].load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot.sequence.load(std::memory_order_relaxed) != sequence)
+                continue;
+
+            if (!present || stored != entityID)
+                return std::nullopt;
+            Component component{};
+            std::memcpy(static_cast<void*>(&component), words.data(), sizeof(Component));
+            return component;
+        }
+    }
+
+    [[nodiscard]] AccessPolicy policy() const noexcept override { return Policy; }
+
+    void publish(Tick tick) noexcept override
+    {
+        for (const Entity::IDType entityID : m_removed)
+            if (Slot& slot = slotOf(entityID); slot.entityID.load(std::memory_order_relaxed) == entityID)
+                write(slot, entityID, nullptr);
+        m_removed.clear();
+
+        const std::span<const Tick> ticks = m_pool.changeTicks();
+        const std::span<const Entity::IDType> entities = m_pool.entities();
+        const std::span<const Component> components = std::as_const(m_pool).components();
+        for (std::size_t slot = 0; slot < ticks.size(); ++slot)
+            if (ticks[slot] > m_publishedTick)
+                write(slotOf(entities[slot]), entities[slot], &components[slot]);
+        m_publishedTick = tick;
+    }
+
+private:
+    using Word = std::uint64_t;
+    static constexpr std::size_t WordCount = (sizeof(Component) + sizeof(Word) - 1) / sizeof(Word);
+    static constexpr std::size_t PageSize = 1024; // Slots per page
+    static constexpr std::size_t PageCount = (std::size_t{ Entity::IndexMask } + 1) / PageSize;
+
+    struct Slot final
+    {
+        std::atomic<std::uint32_t> sequence{}; // Odd while a publish writes the slot
+        std::atomic<Entity::IDType> entityID{};
+        std::atomic<bool> present{};
+        std::array<std::atomic<Word>, WordCount> words{};
+    };
+
+    struct Page final
+    {
+        std::array<Slot, PageSize> slots{};
+    };
+
+    // Get the slot of an entity index, allocating its page on first use
+    [[nodiscard]] Slot& slotOf(Entity::IDType entityID) noexcept
+    {
+        std::atomic<Page*>& page = m_pages[Entity::indexOf(entityID) / PageSize];
+        if (page.load(std::memory_order_relaxed) == nullptr)
+        {
+            m_ownedPages.push_back(std::make_unique<Page>());
+            page.store(m_ownedPages.back().get(), std::memory_order_release);
+        }
+        return page.load(std::memory_order_relaxed)->slots[Entity::indexOf(entityID) % PageSize];
+    }
+
+    // Write a slot between two bumps of its sequence, a null component marks it empty
+    static void write(Slot& slot, Entity::IDType entityID, const Component* component) noexcept
+    {
+        const std::uint32_t sequence = slot.sequence.load(std::memory_order_relaxed);
+        slot.sequence.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        slot.entityID.store(entityID, std::memory_order_relaxed);
+        slot.present.store(component != nullptr, std::memory_order_relaxed);
+        if (component != nullptr)
+        {
+            std::array<Word, WordCount> words{};
+            std::memcpy(words.data(), component, sizeof(Component));
+            for (std::size_t i = 0; i < WordCount; ++i)
+                slot.words[i].store(words[i], std::memory_order_relaxed);
+        }
+        slot.sequence.store(sequence + 2, std::memory_order_release);
+    }
+
+    ComponentPool<Component>& m_pool;
+    ObserverID m_observer{};
+    std::vector<Entity::IDType> m_removed{}; // Entities that lost the component since the previous publish
+    std::array<std::atomic<Page*>, PageCount> m_pages{}; // Page table read by every thread, entries are only ever set once
+    std::vector<std::unique_ptr<Page>> m_ownedPages{};
+    Tick m_publishedTick{}; // Components stamped after this tick are not published yet
+};
+
+// Concept for components that can be copied into the buffers of a double- or triple-buffered pool
+template<class Component>
+concept BufferedComponentConcept = PooledComponentConcept<Component> && std::copyable<Component>;
+
+// Components of a pool as of the end of a tick, with the entity IDs parallel to them and an index to find an entity
+// The live pool is the write buffer, so a refresh copies the components stamped since the frame was last refreshed into it
+// and drops the removed entities instead of swapping storage with the pool, a refresh costs the scan of the change ticks plus one copy per change
+template<BufferedComponentConcept Component>
+class PoolFrame final
+{
+public:
+    // Get the tick the frame was published at
+    [[nodiscard]] Tick tick() const noexcept { return m_tick; }
+
+    // Get a pointer to the component of an entity in the frame, or nullptr if the entity had none
+    [[nodiscard]] const Component* tryGet(Entity::IDType entityID) const noexcept
+    {
+        return m_set.contains(entityID) ? &m_components[m_set.index(entityID)] : nullptr;
+    }
+
+    // Get the dense array of entity IDs, parallel to the component array
+    [[nodiscard]] std::span<const Entity::IDType> entities() const noexcept { return m_set.entities(); }
+
+    // Get the dense array of components
+    [[nodiscard]] std::span<const Component> components() const noexcept { return m_components; }
+
+    // Get the number of components in the frame
+    [[nodiscard]] std::size_t size() const noexcept { return m_components.size(); }
+
+    // Remember that an entity lost its component, it leaves the frame at the next refresh
+    // A frame left behind for as many removals as it has components is rebuilt whole instead of keeping the list growing
+    void markRemoved(Entity::IDType entityID) noexcept
+    {
+        if (m_rebuild)
+            return;
+        if (m_removed.size() < m_components.size())
+            m_removed.push_back(entityID);
+        else
+        {
+            m_removed.clear();
+            m_rebuild = true;
+        }
+    }
+
+    // Bring the frame up to date with a pool, drops the removed entities and copies the components added or changed since the last refresh
+    // The frame keeps its own order, so adds, removes and sorting of the pool copy nothing but the touched components
+    void refresh(const ComponentPool<Component>& pool, Tick tick) noexcept
+    {
+        if (m_rebuild)
+        {
+            m_set.assign(pool.entities());
+            m_components.assign(pool.components().begin(), pool.components().end());
+            m_rebuild = false;
+            m_tick = tick;
+            return;
+        }
+
+        for (const Entity::IDType entityID : m_removed)
+            if (m_set.contains(entityID))
+            {
+                if (const std::size_t slot = m_set.index(entityID); slot != m_components.size() - 1)
+                    m_components[slot] = std::move(m_components.back());
+                m_components.pop_back();
+                m_set.swapAndPop(entityID);
+            }
+        m_removed.clear();
+
+        const std::span<const Tick> ticks = pool.changeTicks();
+        const std::span<const Entity::IDType> entities = pool.entities();
+        const std::span<const Component> components = pool.components();
+        for (std::size_t slot = 0; slot < ticks.size(); ++slot)
+            if (ticks[slot] > m_tick)
+            {
+                if (m_set.contains(entities[slot]))
+                    m_components[m_set.index(entities[slot])] = components[slot];
+                else if (m_set.push(entities[slot]))
+                    m_components.push_back(components[slot]);
+            }
+        m_tick = tick;
+    }
+
+private:
+    SparseSet m_set{};
+    std::vector<Component> m_components{};
+    std::vector<Entity::IDType> m_removed{}; // Entities that lost the component since the last refresh
+    bool m_rebuild{}; // Set once too many removals piled up, the next refresh copies the pool whole
+    Tick m_tick{};
+};
+
+// Double-buffered access policy of a pool, keeps the components of the previous tick next to the live pool
+// Publishing refreshes the older frame and flips the two by index, a frame handed out stays unchanged until the next publish
+// The flip swaps frame indices only, bringing the older frame up to date copies what changed over the last two ticks
+// Meant for the thread running the world or threads in lockstep with its ticks, for example to interpolate between ticks
+template<BufferedComponentConcept Component>
+class DoubleBufferedPool final : public SharedPoolBase
+{
+public:
+    static constexpr AccessPolicy Policy = AccessPolicy::DoubleBuffered;
+
+    explicit DoubleBufferedPool(ComponentPool<Component>& pool) noexcept : m_pool{ pool }
+    {
+        m_observer = m_pool.connectOnRemove([this](Entity::IDType entityID) noexcept
+        {
+            for (PoolFrame<Component>& frame : m_frames)
+                frame.markRemoved(entityID);
+        });
+    }
+
+    DoubleBufferedPool(const DoubleBufferedPool&) = delete;
+    DoubleBufferedPool& operator=(const DoubleBufferedPool&) = delete;
+
+    ~DoubleBufferedPool() noexcept override
+    {
+        m_pool.disconnect(m_observer);
+    }
+
+    // Get the components as of the last publish
+    [[nodiscard]] const PoolFrame<Component>& previous() const noexcept { return m_frames[m_front]; }
+
+    [[nodiscard]] AccessPolicy policy() const noexcept override { return Policy; }
+
+    void publish(Tick tick) noexcept override
+    {
+        m_frames[1 - m_front].refresh(m_pool, tick);
+        m_front = 1 - m_front;
+    }
+
+private:
+    ComponentPool<Component>& m_pool;
+    ObserverID m_observer{};
+    std::array<PoolFrame<Component>, 2> m_frames{};
+    std::size_t m_front{}; // Frame returned by previous
+};
+
+// Triple-buffered access policy of a pool, hands the latest published tick to one reader thread without locking
+// The world thread refreshes its back frame and swaps it with the middle one, the reader swaps the middle one with its front frame
+// Neither side ever waits for the other or touches a frame the other owns
+// The swaps exchange frame indices only, refreshing the back frame copies what changed since that frame was last published
+template<BufferedComponentConcept Component>
+class TripleBufferedPool final : public SharedPoolBase
+{
+public:
+    static constexpr AccessPolicy Policy = AccessPolicy::TripleBuffered;
+
+    // Removals are noted on every frame, including the one the reader holds, whose component arrays the note leaves untouched
+    explicit TripleBufferedPool(ComponentPool<Component>& pool) noexcept : m_pool{ pool }
+    {
+        m_observer = m_pool.connectOnRemove([this](Entity::IDType entityID) noexcept
+        {
+            for (PoolFrame<Component>& frame : m_frames)
+                frame.markRemoved(entityID);
+        });
+    }
+
+    TripleBufferedPool(const TripleBufferedPool&) = delete;
+    TripleBufferedPool& operator=(const TripleBufferedPool&) = delete;
+
+    ~TripleBufferedPool() noexcept override
+    {
+        m_pool.disconnect(m_observer);
+    }
+
+    // Get the latest published frame from the reader thread, it stays unchanged until the next call
+    // Only one thread may read the pool
+    [[nodiscard]] const PoolFrame<Component>& latest() noexcept
+    {
+        if ((m_middle.load(std::memory_order_relaxed) & Fresh) != 0)
+            m_front = m_middle.exchange(m_front, std::memory_order_acq_rel) & IndexMask;
+        return m_frames[m_front];
+    }
+
+    [[nodiscard]] AccessPolicy policy() const noexcept override { return Policy; }
+
+    void publish(Tick tick) noexcept override
+    {
+        m_frames[m_back].refresh(m_pool, tick);
+        m_back = m_middle.exchange(m_back | Fresh, std::memory_order_acq_rel) & IndexMask;
+    }
+
+private:
+    static constexpr std::uint8_t IndexMask = 0b11;
+    static constexpr std::uint8_t Fresh = 0b100; // Set on the middle frame while the reader has not taken it
+
+    ComponentPool<Component>& m_pool;
+    ObserverID m_observer{};
+    std::array<PoolFrame<Component>, 3> m_frames{};
+    std::uint8_t m_back{ 0 }; // Frame refreshed by the world thread
+    std::atomic<std::uint8_t> m_middle{ 1 }; // Frame exchanged between the two sides, with the fresh bit
+    std::uint8_t m_front{ 2 }; // Frame read by the reader thread
+};
+
+// Thread pool where every worker owns a job queue and steals from the others once its own runs dry
+class ThreadPool final
+{
+public:
+    using Job = std::function<void()>;
+    using Counter = std::atomic<std::size_t>; // Number of unfinished jobs of a batch
+
+    explicit ThreadPool(std::size_t threadCount = std::max(std::thread::hardware_concurrency(), 2u) - 1) noexcept
+    {
+        // One queue per worker plus a shared one for jobs submitted from outside the pool
+        for (std::size_t i = 0; i <= threadCount; ++i)
+            m_queues.push_back(std::make_unique<Queue>());
+        for (std::size_t i = 0; i < threadCount; ++i)
+            m_workers.emplace_back([this, i]() noexcept { workerLoop(i); });
+    }
+
+    ThreadPool(const ThreadPool&) noexcept = delete;
+    ThreadPool(ThreadPool&&) noexcept = delete;
+    ThreadPool& operator=(const ThreadPool&) noexcept = delete;
+    ThreadPool& operator=(ThreadPool&&) noexcept = delete;
+
+    ~ThreadPool() noexcept
+    {
+        {
+            std::lock_guard lock{ m_sleepMutex };
+            m_stopping = true;
+        }
+        m_wake.notify_all();
+        for (std::thread& worker : m_workers)
+            worker.join();
+    }
+
+    // Get the number of worker threads
+    [[nodiscard]] std::size_t threadCount() const noexcept { return m_workers.size(); }
+
+    // Get the index of the calling worker in [0, threadCount()], every thread outside the pool gets threadCount()
+    [[nodiscard]] std::size_t workerIndex() const noexcept { return ownQueue(); }
+
+    // Submit a job to the queue of the calling worker, the counter is decremented once the job has finished
+    void submit(Job job, Counter& counter) noexcept
+    {
+        counter.fetch_add(1, std::memory_order_relaxed);
+
+        // Counted before it is queued, a worker may pick it up and uncount it before push_back returns
+        m_pending.fetch_add(1, std::memory_order_relaxed);
+        {
+            Queue& queue = *m_queues[ownQueue()];
+            std::lock_guard lock{ queue.mutex };
+            queue.tasks.push_back(Task{ std::move(job), &counter });
+        }
+        {
+            std::lock_guard lock{ m_sleepMutex };
+        }
+        m_wake.notify_one();
+    }
+
+    // Run pending jobs on the calling thread until every job of the counter has finished
+    void wait(const Counter& counter) noexcept
+    {
+        while (counter.load(std::memory_order_acquire) != 0)
+            if (!runPendingJob(ownQueue()))
+                std::this_thread::yield();
+    }
+
+    // Split [0, count) into chunks, call func(begin, end) for each of them on the pool and wait for all of them
+    template<class Func> requires std::is_nothrow_invocable_v<Func&, std::size_t, std::size_t>
+    void parallelFor(std::size_t count, std::size_t chunkSize, Func&& func) noexcept
+    {
+        Counter counter{};
+        for (std::size_t begin = 0; begin < count; begin += chunkSize)
+        {
+            const std::size_t end = std::min(count, begin + chunkSize);
+            submit([&func, begin, end]() noexcept { func(begin, end); }, counter);
+        }
+        wait(counter);
+    }
+
+private:
+    struct Task final
+    {
+        Job job{};
+        Counter* counter{};
+    };
+
+    struct Queue final
+    {
+        std::mutex mutex{};
+        std::deque<Task> tasks{};
+    };
+
+    // Get the queue of the calling thread, threads outside the pool share the last queue
+    [[nodiscard]] std::size_t ownQueue() const noexcept
+    {
+        return t_owner == this ? t_workerIndex : m_workers.size();
+    }
+
+    // Pop the newest job of the own queue or steal the oldest job of another queue, then run it
+    bool runPendingJob(std::size_t own) noexcept
+    {
+        std::optional<Task> task{};
+        for (std::size_t i = 0; i < m_queues.size() && !task.has_value(); ++i)
+        {
+            Queue& queue = *m_queues[(own + i) % m_queues.size()];
+            std::lock_guard lock{ queue.mutex };
+            if (queue.tasks.empty())
+                continue;
+
+            if (i == 0)
+            {
+                task = std::move(queue.tasks.back());
+                queue.tasks.pop_back();
+            }
+            else
+            {
+                task = std::move(queue.tasks.front());
+                queue.tasks.pop_front();
+            }
+        }
+
+        if (!task.has_value())
+            return false;
+
+        m_pending.fetch_sub(1, std::memory_order_relaxed);
+        task->job();
+        task->counter->fetch_sub(1, std::memory_order_release);
+        return true;
+    }
+
+    // Run jobs until the pool is destroyed, sleeping while there is nothing to do
+    void workerLoop(std::size_t index) noexcept
+    {
+        t_owner = this;
+        t_workerIndex = index;
+        while (true)
+        {
+            if (runPendingJob(index))
+                continue;
+
+            std::unique_lock lock{ m_sleepMutex };
+            m_wake.wait(lock, [this]() noexcept { return m_stopping || m_pending.load(std::memory_order_acquire) != 0; });
+            if (m_stopping && m_pending.load(std::memory_order_acquire) == 0)
+                return;
+        }
+    }
+
+    static inline thread_local const ThreadPool* t_owner{}; // Pool the calling thread works for, if any
+    static inline thread_local std::size_t t_workerIndex{}; // Queue index of the calling worker thread
+
+    std::vector<std::unique_ptr<Queue>> m_queues{};
+    std::vector<std::thread> m_workers{};
+    std::atomic<std::size_t> m_pending{}; // Number of queued jobs not yet picked up
+    std::mutex m_sleepMutex{};
+    std::condition_variable m_wake{};
+    bool m_stopping{};
+};
+
+// Allocator of generational entity IDs, destroyed indices are recycled through an implicit free list
+class EntityRegistry final
+{
+    static constexpr Entity::IDType NoFreeIndex = Entity::IndexMask; // End of the free list, never handed out as an index
+public:
+    // Create an entity, reusing the most recently freed index with its bumped generation
+    // Returns an entity with the ID Entity::Invalid once every index is taken
+    [[nodiscard]] Entity create() noexcept
+    {
+        if (m_freeHead != NoFreeIndex)
+        {
+            const Entity::IDType index = m_freeHead;
+            m_freeHead = Entity::indexOf(m_entities[index]);
+            m_entities[index] = Entity::makeID(index, Entity::generationOf(m_entities[index]));
+            ++m_alive;
+            return Entity{ m_entities[index] };
+        }
+
+        // The last index ends the free list and any later one would alias a live slot once masked
+        if (m_entities.size() >= NoFreeIndex)
+            return Entity{ Entity::Invalid };
+
+        const Entity::IDType index = static_cast<Entity::IDType>(m_entities.size());
+        m_entities.push_back(Entity::makeID(index, 0));
+        ++m_alive;
+        return Entity{ m_entities[index] };
+    }
+
+    // Destroy an entity, its index goes to the free list and its generation is bumped, returns false for stale IDs
+    bool destroy(Entity::IDType entityID) noexcept
+    {
+        if (!isAlive(entityID))
+            return false;
+
+        // A freed slot keeps the next free index in its index bits and the generation of the next ID in its generation bits
+        const Entity::IDType index = Entity::indexOf(entityID);
+        m_entities[index] = Entity::makeID(m_freeHead, Entity::generationOf(entityID) + 1);
+        m_freeHead = index;
+        --m_alive;
+        return true;
+    }
+
+    // Check if an entity ID was created by the registry and not destroyed since
+    [[nodiscard]] bool isAlive(Entity::IDType entityID) const noexcept
+    {
+        const Entity::IDType index = Entity::indexOf(entityID);
+        return index < m_entities.size() && m_entities[index] == entityID;
+    }
+
+    // Make a specific ID alive, replacing a live ID of another generation at its index, returns false for the reserved last index
+    // Used by replicas mirroring the IDs of another world, indices skipped to reach the ID go to the free list
+    bool adopt(Entity::IDType entityID) noexcept
+    {
+        const Entity::IDType index = Entity::indexOf(entityID);
+        if (index == NoFreeIndex)
+            return false;
+
+        if (index >= m_entities.size())
+        {
+            for (Entity::IDType skipped = static_cast<Entity::IDType>(m_entities.size()); skipped < index; ++skipped)
+            {
+                m_entities.push_back(Entity::makeID(m_freeHead, 0));
+                m_freeHead = skipped;
+            }
+            m_entities.push_back(entityID);
+            ++m_alive;
+            return true;
+        }
+
+        if (Entity::indexOf(m_entities[index]) == index)
+        {
+            m_entities[index] = entityID;
+            return true;
+        }
+
+        // Unlink the index from the free list, keeping the generation stored in the previous link
+        if (m_freeHead == index)
+            m_freeHead = Entity::indexOf(m_entities[index]);
+        else
+        {
+            Entity::IDType previous = m_freeHead;
+            while (Entity::indexOf(m_entities[previous]) != index)
+                previous = Entity::indexOf(m_entities[previous]);
+            m_entities[previous] = Entity::makeID(Entity::indexOf(m_entities[index]), Entity::generationOf(m_entities[previous]));
+        }
+        m_entities[index] = entityID;
+        ++m_alive;
+        return true;
+    }
+
+    // Get the number of live entities
+    [[nodiscard]] std::size_t size() const noexcept { return m_alive; }
+
+    // Get the ID or free list link of every index, used to save the registry
+    [[nodiscard]] std::span<const Entity::IDType> slots() const noexcept { return m_entities; }
+
+    // Get the first index of the free list, used to save the registry
+    [[nodiscard]] Entity::IDType freeHead() const noexcept { return m_freeHead; }
+
+    // Rebuild a registry from saved slots and free list head, an index is alive when its slot holds its own index
+    // Returns an empty optional if there are more slots than indices or the free list doesn't link every freed index exactly once
+    [[nodiscard]] static std::optional<EntityRegistry> restore(std::span<const Entity::IDType> slots, Entity::IDType freeHead) noexcept
+    {
+        if (slots.size() > NoFreeIndex)
+            return std::nullopt;
+
+        EntityRegistry registry{};
+        registry.m_entities.assign(slots.begin(), slots.end());
+        registry.m_freeHead = freeHead;
+        for (std::size_t index = 0; index < slots.size(); ++index)
+            registry.m_alive += Entity::indexOf(slots[index]) == index;
+
+        std::size_t unlinked = slots.size() - registry.m_alive;
+        std::vector<bool> linked(slots.size());
+        for (Entity::IDType index = freeHead; index != NoFreeIndex; index = Entity::indexOf(slots[index]))
+        {
+            if (index >= slots.size() || Entity::indexOf(slots[index]) == index || linked[index])
+                return std::nullopt;
+            linked[index] = true;
+            --unlinked;
+        }
+        if (unlinked != 0)
+            return std::nullopt;
+        return std::optional<EntityRegistry>{ std::move(registry) };
+    }
+
+private:
+    std::vector<Entity::IDType> m_entities{}; // Current ID of every index, or the free list link of a freed index
+    Entity::IDType m_freeHead{ NoFreeIndex };
+    std::size_t m_alive{};
+};
+
+// Buffer recording structural changes to replay them later in one sorted batch, components are kept in an arena until then
+class CommandBuffer final
+{
+    static constexpr std::size_t InitialArenaSize = 16 * 1024; // Size of the first arena block in bytes
+public:
+    // Kind of a recorded structural change
+    enum class CommandKind : std::uint8_t
+    {
+        Add,
+        Set,
+        Remove,
+        Destroy
+    };
+
+    // Recorded structural change, commands of one component type are replayed together through type-erased functions
+    struct Command final
+    {
+        ComponentTypeID type{}; // Component type, destroy commands use the largest ID so they replay last
+        CommandKind kind{};
+        Entity::IDType entityID{};
+        void* component{}; // Arena copy of an added component
+        void (*apply)(PoolBase& pool, std::span<const Command> commands) noexcept {}; // Move a run of added or written components into their pool
+        std::unique_ptr<PoolBase> (*makePool)(std::pmr::memory_resource* resource) noexcept {}; // Create the pool of the component type if the world has none yet
+        void (*discard)(void* component) noexcept {}; // Destroy an added component that is never replayed
+    };
+
+    CommandBuffer() noexcept = default;
+    CommandBuffer(const CommandBuffer&) noexcept = delete;
+    CommandBuffer(CommandBuffer&&) noexcept = delete;
+    CommandBuffer& operator=(const CommandBuffer&) noexcept = delete;
+    CommandBuffer& operator=(CommandBuffer&&) noexcept = delete;
+    ~CommandBuffer() noexcept { clear(); }
+
+    // Record adding a component to an entity, adds to entities destroyed before the replay are dropped
+    template<ComponentConcept Component>
+    void addComponent(Entity::IDType entityID, Component&& component) noexcept
+    {
+        void* memory = m_arena.allocate(sizeof(Component), alignof(Component));
+        m_commands.push_back(Command
+        {
+            componentTypeID<Component>(),
+            CommandKind::Add,
+            entityID,
+            ::new (memory) Component(std::move(component)),
+            &applyAdds<Component>,
+            [](std::pmr::memory_resource* resource) noexcept -> std::unique_ptr<PoolBase> { return std::make_unique<PoolType<Component>>(resource); },
+            [](void* component) noexcept { static_cast<Component*>(component)->~Component(); }
+        });
+    }
+
+    // Record writing a component of an entity, replayed as an assignment that counts as a change, or as an add if the entity has none
+    // Writes to entities destroyed before the replay are dropped
+    template<PooledComponentConcept Component>
+    void setComponent(Entity::IDType entityID, Component&& component) noexcept
+    {
+        void* memory = m_arena.allocate(sizeof(Component), alignof(Component));
+        m_commands.push_back(Command
+        {
+            componentTypeID<Component>(),
+            CommandKind::Set,
+            entityID,
+            ::new (memory) Component(std::move(component)),
+            &applySets<Component>,
+            [](std::pmr::memory_resource* resource) noexcept -> std::unique_ptr<PoolBase> { return std::make_unique<ComponentPool<Component>>(resource); },
+            [](void* component) noexcept { static_cast<Component*>(component)->~Component(); }
+        });
+    }
+
+    // Record removing a component from an entity
+    template<ComponentConcept Component>
+    void removeComponent(Entity::IDType entityID) noexcept
+    {
+        m_commands.push_back(Command{ componentTypeID<Component>(), CommandKind::Remove, entityID });
+    }
+
+    // Record destroying an entity
+    void destroyEntity(Entity::IDType entityID) noexcept
+    {
+        m_commands.push_back(Command{ std::numeric_limits<ComponentTypeID>::max(), CommandKind::Destroy, entityID });
+    }
+
+    // Get the recorded commands in recording order
+    [[nodiscard]] std::span<const Command> commands() const noexcept { return m_commands; }
+
+    // Check if nothing is recorded
+    [[nodiscard]] bool empty() const noexcept { return m_commands.empty(); }
+
+    // Forget the commands after they were replayed and reset the arena, replaying already consumed the components
+    void release() noexcept
+    {
+        m_commands.clear();
+        m_arena.release();
+    }
+
+    // Drop the recorded commands without replaying them
+    void clear() noexcept
+    {
+        for (const Command& command : m_commands)
+            if (command.kind == CommandKind::Add || command.kind == CommandKind::Set)
+                command.discard(command.component);
+        release();
+    }
+
+private:
+    // Move a run of added components of one type into their pool, the pool grows once for the whole run
+    template<ComponentConcept Component>
+    static void applyAdds(PoolBase& base, std::span<const Command> commands) noexcept
+    {
+        PoolType<Component>& pool = static_cast<PoolType<Component>&>(base);
+        pool.reserve(pool.size() + commands.size());
+        for (const Command& command : commands)
+        {
+            Component* component = static_cast<Component*>(command.component);
+            pool.emplace(command.entityID, std::move(*component));
+            component->~Component();
+        }
+    }
+
+    // Move a run of written components of one type into their pool, assigning over existing components and adding the others
+    template<PooledComponentConcept Component>
+    static void applySets(PoolBase& base, std::span<const Command> commands) noexcept
+    {
+        ComponentPool<Component>& pool = static_cast<ComponentPool<Component>&>(base);
+        for (const Command& command : commands)
+        {
+            Component* component = static_cast<Component*>(command.component);
+            if (Component* existing = pool.tryGet(command.entityID); existing != nullptr)
+            {
+                *existing = std::move(*component);
+                pool.markChanged(command.entityID);
+            }
+            else
+                pool.emplace(command.entityID, std::move(*component));
+            component->~Component();
+        }
+    }
+
+    std::pmr::monotonic_buffer_resource m_arena{ InitialArenaSize };
+    std::vector<Command> m_commands{}; // Keeps its capacity across ticks
+};
+
+// Shared state of a world and its async systems, resumes them on a thread pool and collects the commands they record
+class AsyncSystemQueue final
+{
+public:
+    explicit AsyncSystemQueue(ThreadPool& pool) noexcept : m_pool{ pool } {}
+
+    AsyncSystemQueue(const AsyncSystemQueue&) noexcept = delete;
+    AsyncSystemQueue(AsyncSystemQueue&&) noexcept = delete;
+    AsyncSystemQueue& operator=(const AsyncSystemQueue&) noexcept = delete;
+    AsyncSystemQueue& operator=(AsyncSystemQueue&&) noexcept = delete;
+
+    // Count a new async system as in flight and run it on the thread pool until it first suspends
+    void launch(std::coroutine_handle<> handle) noexcept
+    {
+        m_inFlight.fetch_add(1, std::memory_order_relaxed);
+        resume(handle);
+    }
+
+    // Resume a suspended async system on the thread pool, callable from any thread
+    void resume(std::coroutine_handle<> handle) noexcept
+    {
+        m_pool.submit([handle]() noexcept { handle.resume(); }, m_jobs);
+    }
+
+    // Count an async system as done, called by the system itself right before it is destroyed
+    void finish() noexcept
+    {
+        m_inFlight.fetch_sub(1, std::memory_order_release);
+    }
+
+    // Get the number of async systems launched and not yet done
+    [[nodiscard]] std::size_t inFlight() const noexcept { return m_inFlight.load(std::memory_order_acquire); }
+
+    // Run jobs on the calling thread until every async system is done, systems awaiting I/O keep it waiting
+    void wait() noexcept
+    {
+        while (inFlight() != 0)
+        {
+            m_pool.wait(m_jobs);
+            std::this_thread::yield();
+        }
+        m_pool.wait(m_jobs);
+    }
+
+    // Get an empty command buffer for an async system, reusing one handed back by a flush
+    [[nodiscard]] std::unique_ptr<CommandBuffer> acquire() noexcept
+    {
+        std::lock_guard lock{ m_mutex };
+        if (m_free.empty())
+            return std::make_unique<CommandBuffer>();
+
+        std::unique_ptr<CommandBuffer> buffer = std::move(m_free.back());
+        m_free.pop_back();
+        return buffer;
+    }
+
+    // Hand the commands recorded by an async system over to the next flush
+    void push(std::unique_ptr<CommandBuffer> buffer) noexcept
+    {
+        std::lock_guard lock{ m_mutex };
+        m_ready.push_back(std::move(buffer));
+    }
+
+    // Take every command buffer handed over since the previous call
+    [[nodiscard]] std::vector<std::unique_ptr<CommandBuffer>> take() noexcept
+    {
+        std::lock_guard lock{ m_mutex };
+        return std::exchange(m_ready, {});
+    }
+
+    // Give replayed command buffers back for reuse
+    void recycle(std::vector<std::unique_ptr<CommandBuffer>> buffers) noexcept
+    {
+        std::lock_guard lock{ m_mutex };
+        std::ranges::move(buffers, std::back_inserter(m_free));
+    }
+
+private:
+    ThreadPool& m_pool;
+    ThreadPool::Counter m_jobs{}; // Resumptions queued or running on the thread pool
+    std::atomic<std::size_t> m_inFlight{};
+    std::mutex m_mutex{};
+    std::vector<std::unique_ptr<CommandBuffer>> m_ready{}; // Recorded commands waiting for a flush
+    std::vector<std::unique_ptr<CommandBuffer>> m_free{}; // Replayed buffers kept for reuse
+};
+
+// Handle an async system records its writes through, owned by its coroutine
+class AsyncContext final
+{
+public:
+    // The system object is shared by every coroutine started by the same call and released with the last of them
+    AsyncContext(AsyncSystemQueue& queue, std::shared_ptr<const void> system) noexcept : m_queue{ queue }, m_system{ std::move(system) } {}
+
+    // Get the command buffer of the system, its commands are replayed by the first flushCommands after the system suspends or finishes
+    [[nodiscard]] CommandBuffer& commands() noexcept
+    {
+        if (!m_commands)
+            m_commands = m_queue.acquire();
+        return *m_commands;
+    }
+
+    // Hand the commands recorded since the system last suspended over to the world
+    void handOver() noexcept
+    {
+        if (m_commands && !m_commands->empty())
+            m_queue.push(std::move(m_commands));
+    }
+
+    // Get the queue resuming the system
+    [[nodiscard]] AsyncSystemQueue& queue() noexcept { return m_queue; }
+
+private:
+    AsyncSystemQueue& m_queue;
+    std::shared_ptr<const void> m_system{}; // Keeps the system object the coroutine runs a member of alive
+    std::unique_ptr<CommandBuffer> m_commands{};
+};
+
+// Coroutine returned by an async system, it starts on the thread pool and is resumed there whenever what it awaits completes
+// While suspended it holds no thread, it destroys itself once it returns
+class AsyncTask final
+{
+public:
+    struct promise_type final
+    {
+        [[nodiscard]] AsyncTask get_return_object() noexcept { return AsyncTask{ std::coroutine_handle<promise_type>::from_promise(*this) }; }
+        [[nodiscard]] std::suspend_always initial_suspend() const noexcept { return {}; }
+        [[nodiscard]] std::suspend_never final_suspend() const noexcept { return {}; }
+
+        void return_void() noexcept
+        {
+            context->handOver();
+            context->queue().finish();
+        }
+
+        [[noreturn]] void unhandled_exception() const noexcept { std::terminate(); }
+
+        std::unique_ptr<AsyncContext> context{}; // Set by the world before the system first runs
+    };
+
+    AsyncTask(const AsyncTask&) noexcept = delete;
+    AsyncTask& operator=(const AsyncTask&) noexcept = delete;
+    AsyncTask(AsyncTask&& other) noexcept : m_handle{ std::exchange(other.m_handle, {}) } {}
+    AsyncTask& operator=(AsyncTask&&) noexcept = delete;
+
+    // Destroy a task that was never started
+    ~AsyncTask() noexcept
+    {
+        if (m_handle)
+            m_handle.destroy();
+    }
+
+    // Give the task its context and start it on the thread pool, the task owns itself from then on
+    void start(std::unique_ptr<AsyncContext> context) noexcept
+    {
+        AsyncSystemQueue& queue = context->queue();
+        m_handle.promise().context = std::move(context);
+        queue.launch(std::exchange(m_handle, {}));
+    }
+
+private:
+    explicit AsyncTask(std::coroutine_handle<promise_type> handle) noexcept : m_handle{ handle } {}
+
+    std::coroutine_handle<promise_type> m_handle{};
+};
+
+// Value an async system awaits, completed once from any thread, for example by the callback of an I/O request
+// Awaiting hands the commands recorded so far over to the world, completing resumes the system on the thread pool
+template<std::movable T>
+class AsyncValue final
+{
+public:
+    // Store the value and resume the system awaiting it, if any
+    void complete(T value) noexcept
+    {
+        m_value.emplace(std::move(value));
+        if (m_state.exchange(Completed, std::memory_order_acq_rel) == Waiting)
+            m_waiting.promise().context->queue().resume(m_waiting);
+    }
+
+    // Awaiter suspending the system until the value is completed
+    struct Awaiter final
+    {
+        [[nodiscard]] bool await_ready() const noexcept { return value.m_state.load(std::memory_order_acquire) == Completed; }
+
+        // Suspend unless the value was completed in the meantime, the system may be resumed on another thread before this returns
+        [[nodiscard]] bool await_suspend(std::coroutine_handle<AsyncTask::promise_type> handle) noexcept
+        {
+            handle.promise().context->handOver();
+            value.m_waiting = handle;
+            std::uint8_t expected = Empty;
+            return value.m_state.compare_exchange_strong(expected, Waiting, std::memory_order_acq_rel, std::memory_order_acquire);
+        }
+
+        [[nodiscard]] T await_resume() const noexcept { return std::move(*value.m_value); }
+
+        AsyncValue& value;
+    };
+
+    [[nodiscard]] Awaiter operator co_await() noexcept { return Awaiter{ *this }; }
+
+private:
+    static constexpr std::uint8_t Empty = 0;
+    static constexpr std::uint8_t Waiting = 1;
+    static constexpr std::uint8_t Completed = 2;
+
+    std::optional<T> m_value{};
+    std::coroutine_handle<AsyncTask::promise_type> m_waiting{};
+    std::atomic<std::uint8_t> m_state{ Empty };
+};
+
+// Check that the call operator of an async system takes the entity ID, the component and the extra arguments by value
+template<class CallOperator>
+struct AsyncParametersByValue : std::false_type {};
+
+template<class System, class... Params>
+struct AsyncParametersByValue<AsyncTask (System::*)(Entity::IDType, typename System::ComponentType, AsyncContext&, Params...) noexcept>
+    : std::bool_constant<(!std::is_reference_v<Params> && ...)> {};
+
+template<class System, class... Params>
+struct AsyncParametersByValue<AsyncTask (System::*)(Entity::IDType, typename System::ComponentType, AsyncContext&, Params...) const noexcept>
+    : std::bool_constant<(!std::is_reference_v<Params> && ...)> {};
+
+// Concept for systems run as coroutines on a copy of every component of their type
+// They get the entity ID, the component and a context to record writes through
+// Every other argument is taken by value, a reference would dangle once the call returns at the first suspension
+template<class System, class... Args>
+concept AsyncSystemConcept = PooledComponentConcept<typename System::ComponentType> && std::copyable<typename System::ComponentType>
+    && std::is_nothrow_invocable_r_v<AsyncTask, System&, Entity::IDType, typename System::ComponentType, AsyncContext&, Args...>
+    && AsyncParametersByValue<decltype(&System::operator())>::value;
+
+// Binary snapshot layout, every block starts on a BlockAlignment boundary so a mapped file can be used in place
+// Header, entity registry slots, then for each component type: pool header, entity IDs and raw components
+struct Snapshot final
+{
+    static constexpr std::uint32_t Magic = 0x53534345; // "ECSS" read as little-endian bytes
+    static constexpr std::uint32_t Version = 1;
+    static constexpr std::size_t BlockAlignment = 64;
+
+    struct Header final
+    {
+        std::uint32_t magic{ Magic };
+        std::uint32_t version{ Version };
+        std::uint32_t indexBits{ Entity::IndexBits };
+        std::uint32_t poolCount{};
+        std::uint64_t slotCount{}; // Number of entity registry slots
+        Entity::IDType freeHead{}; // Head of the registry free list
+        std::uint32_t reserved{};
+    };
+
+    struct PoolHeader final
+    {
+        std::uint64_t count{}; // Number of components of the pool
+        std::uint32_t componentSize{};
+        std::uint32_t componentAlignment{};
+    };
+
+    // Cursor over the blocks of a snapshot in memory, every taken block is bounds checked
+    class Reader final
+    {
+    public:
+        explicit Reader(std::span<const std::byte> bytes) noexcept : m_bytes{ bytes } {}
+
+        // Take the next block of count objects, or an empty optional if the snapshot is too short
+        template<class T> requires std::is_trivially_copyable_v<T>
+        [[nodiscard]] std::optional<std::span<const T>> take(std::size_t count) noexcept
+        {
+            const std::size_t size = count * sizeof(T);
+            if (count > m_bytes.size() / sizeof(T) || size > m_bytes.size() - m_offset)
+                return std::nullopt;
+
+            const std::span<const T> block{ reinterpret_cast<const T*>(m_bytes.data() + m_offset), count };
+            m_offset = std::min(m_bytes.size(), (m_offset + size + BlockAlignment - 1) / BlockAlignment * BlockAlignment);
+            return block;
+        }
+
+    private:
+        std::span<const std::byte> m_bytes{};
+        std::size_t m_offset{};
+    };
+
+    // Append blocks to a file, padding each one to the block alignment
+    class Writer final
+    {
+    public:
+        explicit Writer(std::FILE* file) noexcept : m_file{ file } {}
+
+        // Write a block of objects, returns false once any write failed
+        template<class T> requires std::is_trivially_copyable_v<T>
+        bool write(std::span<const T> block) noexcept
+        {
+            static constexpr std::byte Padding[BlockAlignment]{};
+            const std::size_t size = block.size_bytes();
+            const std::size_t padding = (BlockAlignment - size % BlockAlignment) % BlockAlignment;
+            m_good = m_good && std::fwrite(block.data(), 1, size, m_file) == size && std::fwrite(Padding, 1, padding, m_file) == padding;
+            return m_good;
+        }
+
+    private:
+        std::FILE* m_file{};
+        bool m_good{ true };
+    };
+};
+
+// Read-only view of a whole file, memory-mapped where the platform supports it and read into memory otherwise
+class MappedFile final
+{
+public:
+    explicit MappedFile(const char* path) noexcept
+    {
+#if ECS_HAS_MMAP
+        const int descriptor = ::open(path, O_RDONLY);
+        if (descriptor < 0)
+            return;
+
+        struct stat status{};
+        if (::fstat(descriptor, &status) == 0 && status.st_size > 0)
+        {
+            void* mapping = ::mmap(nullptr, static_cast<std::size_t>(status.st_size), PROT_READ, MAP_PRIVATE, descriptor, 0);
+            if (mapping != MAP_FAILED)
+                m_bytes = std::span<const std::byte>{ static_cast<const std::byte*>(mapping), static_cast<std::size_t>(status.st_size) };
+        }
+        ::close(descriptor);
+#else
+        // Read into a buffer aligned like the snapshot blocks, so components with a large alignment can be used in place
+        if (std::FILE* file = std::fopen(path, "rb"))
+        {
+            if (std::fseek(file, 0, SEEK_END) == 0)
+                if (const long size = std::ftell(file); size > 0 && std::fseek(file, 0, SEEK_SET) == 0)
+                {
+                    m_buffer = static_cast<std::byte*>(::operator new(static_cast<std::size_t>(size), std::align_val_t{ Snapshot::BlockAlignment }, std::nothrow));
+                    if (m_buffer != nullptr && std::fread(m_buffer, 1, static_cast<std::size_t>(size), file) == static_cast<std::size_t>(size))
+                        m_bytes = std::span<const std::byte>{ m_buffer, static_cast<std::size_t>(size) };
+                }
+            std::fclose(file);
+        }
+#endif
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile(MappedFile&&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile& operator=(MappedFile&&) = delete;
+
+    ~MappedFile() noexcept
+    {
+#if ECS_HAS_MMAP
+        if (!m_bytes.empty())
+            ::munmap(const_cast<std::byte*>(m_bytes.data()), m_bytes.size());
+#else
+        ::operator delete(m_buffer, std::align_val_t{ Snapshot::BlockAlignment });
+#endif
+    }
+
+    // Get the contents of the file, empty if it could not be opened
+    [[nodiscard]] std::span<const std::byte> bytes() const noexcept { return m_bytes; }
+
+private:
+    std::span<const std::byte> m_bytes{};
+#if !ECS_HAS_MMAP
+    std::byte* m_buffer{}; // Contents of the file, aligned to Snapshot::BlockAlignment
+#endif
+};
+
+#undef ECS_HAS_MMAP
+
+// Component types a snapshot can store as raw bytes
+template<class Component>
+concept SnapshotComponentConcept = PooledComponentConcept<Component> && std::is_trivially_copyable_v<Component>
+    && alignof(Component) <= Snapshot::BlockAlignment;
+
+#if ECS_PROFILING
+// Readable name of a type taken from the signature of a function template, used to label profiled systems
+template<class T>
+[[nodiscard]] constexpr std::string_view typeName() noexcept
+{
+#if defined(_MSC_VER)
+    constexpr std::string_view signature = __FUNCSIG__;
+    constexpr std::size_t begin = signature.find("typeName<") + 9;
+    constexpr std::size_t end = signature.rfind(">(void)");
+#else
+    constexpr std::string_view signature = __PRETTY_FUNCTION__;
+    constexpr std::size_t begin = signature.find("T = ") + 4;
+    constexpr std::size_t end = signature.find_first_of(";]", begin);
+#endif
+    return signature.substr(begin, end - begin);
+}
+
+// Recorder of the time systems take, collects trace events and per tick totals of every system
+class Profiler final
+{
+public:
+    // What a profiled region contributes to, parallel chunks only add trace events so the totals count each run once
+    enum class Record : std::uint8_t
+    {
+        TraceAndTotals,
+        Trace,
+        Totals
+    };
+
+    // Timed region of a system run on one thread, times are in nanoseconds since the profiler was created
+    struct Event final
+    {
+        std::string_view name{};
+        Tick tick{};
+        std::size_t thread{}; // Worker index, threads outside the thread pool share the last index
+        std::int64_t start{};
+        std::int64_t duration{};
+        std::size_t entities{}; // Slots visited
+        std::size_t bytes{}; // Component bytes behind the visited slots
+    };
+
+    // Totals of one system over a tick
+    struct SystemTotals final
+    {
+        std::string_view name{};
+        std::size_t runs{};
+        std::size_t entities{};
+        std::size_t bytes{};
+        std::int64_t duration{};
+    };
+
+    // Create a profiler for a thread pool with a number of workers, each of them gets its own slot for accumulated runs
+    explicit Profiler(std::size_t workerCount = 0) noexcept : m_slots(workerCount + 1) {}
+
+    // Get the nanoseconds elapsed since the profiler was created
+    [[nodiscard]] std::int64_t now() const noexcept
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_origin).count();
+    }
+
+    // Record a timed region, safe to call from any thread
+    void record(const Event& event, Record record) noexcept
+    {
+        const std::lock_guard lock{ m_mutex };
+        if (record != Record::Totals)
+            m_events.push_back(event);
+        if (record == Record::Trace)
+            return;
+
+        add(m_tickTotals, SystemTotals{ event.name, 1, event.entities, event.bytes, event.duration });
+    }
+
+    // Add a run to the totals of the current tick without a trace event, for per-entity calls too frequent to take the lock
+    // Workers and the thread that created the profiler add to their own slot, other threads fall back to the locked totals
+    void accumulate(std::size_t worker, const SystemTotals& run) noexcept
+    {
+        if (worker + 1 < m_slots.size())
+            add(m_slots[worker], run);
+        else if (std::this_thread::get_id() == m_owner)
+            add(m_slots.back(), run);
+        else
+        {
+            const std::lock_guard lock{ m_mutex };
+            add(m_tickTotals, run);
+        }
+    }
+
+    // Close the current tick, its totals and accumulated runs become the last tick totals, must not race with recording
+    void endTick() noexcept
+    {
+        const std::lock_guard lock{ m_mutex };
+        for (std::vector<SystemTotals>& slot : m_slots)
+        {
+            for (const SystemTotals& run : slot)
+                add(m_tickTotals, run);
+            slot.clear();
+        }
+        m_lastTickTotals.swap(m_tickTotals);
+        m_tickTotals.clear();
+    }
+
+    // Get the totals of every system run during the last closed tick, must not race with recording
+    [[nodiscard]] std::span<const SystemTotals> lastTickTotals() const noexcept { return m_lastTickTotals; }
+
+    // Get every recorded trace event, must not race with recording
+    [[nodiscard]] std::span<const Event> events() const noexcept { return m_events; }
+
+    // Write the trace events in the Chrome trace event format, loadable in chrome://tracing, Perfetto and Tracy's importer
+    // Returns false if the file can't be written, the events are kept so a failed export can be retried
+    bool writeChromeTrace(const char* path) const noexcept
+    {
+        std::FILE* file = std::fopen(path, "w");
+        if (!file)
+            return false;
+
+        const std::lock_guard lock{ m_mutex };
+        bool written = std::fputs("{\"traceEvents\":[\n", file) >= 0;
+        for (std::size_t i = 0; i < m_events.size() && written; ++i)
+        {
+            const Event& event = m_events[i];
+            written = std::fprintf(file, "%s{\"name\":\"%.*s\",\"ph\":\"X\",\"pid\":0,\"tid\":%zu,\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"tick\":%u,\"entities\":%zu,\"bytes\":%zu}}\n",
+                i == 0 ? "" : ",", static_cast<int>(event.name.size()), event.name.data(), event.thread, static_cast<double>(event.start) / 1000.0,
+                static_cast<double>(event.duration) / 1000.0, static_cast<unsigned>(event.tick), event.entities, event.bytes) >= 0;
+        }
+        written = written && std::fputs("]}\n", file) >= 0;
+        return std::fclose(file) == 0 && written;
+    }
+
+    // Drop every recorded trace event, totals are kept
+    void clearEvents() noexcept
+    {
+        const std::lock_guard lock{ m_mutex };
+        m_events.clear();
+    }
+
+private:
+    // Add a run to the totals of its system
+    static void add(std::vector<SystemTotals>& totals, const SystemTotals& run) noexcept
+    {
+        auto found = std::ranges::find(totals, run.name, &SystemTotals::name);
+        if (found == totals.end())
+            found = totals.insert(totals.end(), SystemTotals{ run.name });
+        found->runs += run.runs;
+        found->entities += run.entities;
+        found->bytes += run.bytes;
+        found->duration += run.duration;
+    }
+
+    std::chrono::steady_clock::time_point m_origin{ std::chrono::steady_clock::now() };
+    std::thread::id m_owner{ std::this_thread::get_id() };
+    mutable std::mutex m_mutex{};
+    std::vector<Event> m_events{};
+    std::vector<SystemTotals> m_tickTotals{}; // Totals of the current tick
+    std::vector<SystemTotals> m_lastTickTotals{};
+    std::vector<std::vector<SystemTotals>> m_slots{}; // Runs accumulated by every worker, the last slot is the owner thread's
+};
+
+// Timed region recorded to a profiler when it goes out of scope
+class ProfileScope final
+{
+public:
+    ProfileScope(Profiler& profiler, Profiler::Record record, Profiler::Event event) noexcept
+        : m_profiler{ profiler }, m_record{ record }, m_event{ event }
+    {
+        m_event.start = profiler.now();
+    }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+    ~ProfileScope() noexcept
+    {
+        m_event.duration = m_profiler.now() - m_event.start;
+        m_profiler.record(m_event, m_record);
+    }
+
+private:
+    Profiler& m_profiler;
+    Profiler::Record m_record{};
+    Profiler::Event m_event{};
+};
+
+// Timed run of a system on a single entity, accumulated to a profiler when it goes out of scope
+class AccumulateScope final
+{
+public:
+    AccumulateScope(Profiler& profiler, std::size_t worker, std::string_view name, std::size_t bytes) noexcept
+        : m_profiler{ profiler }, m_worker{ worker }, m_run{ name, 1, 1, bytes }, m_start{ profiler.now() } {}
+
+    AccumulateScope(const AccumulateScope&) = delete;
+    AccumulateScope& operator=(const AccumulateScope&) = delete;
+
+    ~AccumulateScope() noexcept
+    {
+        m_run.duration = m_profiler.now() - m_start;
+        m_profiler.accumulate(m_worker, m_run);
+    }
+
+private:
+    Profiler& m_profiler;
+    std::size_t m_worker{};
+    Profiler::SystemTotals m_run{};
+    std::int64_t m_start{};
+};
+
+// Profile the rest of the enclosing scope as a run of a system over a number of entities with a number of component bytes
+#define ECS_PROFILE_SYSTEM(System, record, entities, bytes) \
+    const ProfileScope ecsProfileScope{ m_profiler, Profiler::Record::record, Profiler::Event{ typeName<System>(), m_tick, threadPool().workerIndex(), 0, 0, entities, bytes } }
+// Profile the rest of the enclosing scope as a run of a system on one entity, added to the totals without locking or a trace event
+#define ECS_PROFILE_ENTITY(System, bytes) \
+    const AccumulateScope ecsProfileScope{ m_profiler, threadPool().workerIndex(), typeName<System>(), bytes }
+// Capture the world in lambdas that profile their body
+#define ECS_PROFILE_CAPTURE this,
+#else
+#define ECS_PROFILE_SYSTEM(System, record, entities, bytes) static_cast<void>(0)
+#define ECS_PROFILE_ENTITY(System, bytes) static_cast<void>(0)
+#define ECS_PROFILE_CAPTURE
+#endif
+
+// World (Entity-Component-System) owning the component pools of one simulation, worlds are fully isolated from each other
+class World final
+{
+public:
+    // Create a world whose pools allocate from a per-world pool arena fed by the upstream resource
+    explicit World(std::pmr::memory_resource* upstream = std::pmr::get_default_resource()) noexcept
+        : m_arena{ std::make_unique<std::pmr::unsynchronized_pool_resource>(upstream) }
+    {
+        // One command buffer per worker of the thread pool, threads outside of it get their own on first use
+        for (std::size_t i = 0; i < threadPool().threadCount(); ++i)
+            m_commandBuffers.push_back(std::make_unique<CommandBuffer>());
+    }
+
+    World(const World&) noexcept = delete;
+    World(World&&) noexcept = delete;
+    World& operator=(const World&) noexcept = delete;
+    World& operator=(World&&) noexcept = delete;
+    ~World() noexcept = default;
+
+    // Add a component to an entity, IDs of destroyed entities and relationships to destroyed parents are ignored
+    template<ComponentConcept Component>
+    void addComponentToEntity(Entity::IDType entityID, Component&& component) noexcept
+    {
+        if (accepts(entityID, component))
+            get<Component>().emplace(entityID, std::move(component));
+    }
+
+    // Remove a component from an entity, swap-and-pop by default or order preserving on request
+    template<ComponentConcept Component>
+    void removeComponentFromEntity(Entity::IDType entityID, RemovalOrder order = RemovalOrder::SwapAndPop) noexcept
+    {
+        get<Component>().erase(entityID, order);
+    }
+
+    // Reserve room for a number of components of a type, below that capacity the pool never reallocates so growth never copies
+    template<ComponentConcept Component>
+    void reserve(std::size_t capacity) noexcept
+    {
+        get<Component>().reserve(capacity);
+    }
+
+    // Get the memory held by the pool of a component type, all zeros if the world never stored one
+    template<ComponentConcept Component>
+    [[nodiscard]] PoolStats poolStats() const noexcept
+    {
+        const PoolType<Component>* pool = find<Component>();
+        return pool != nullptr ? pool->stats() : PoolStats{};
+    }
+
+    // Get the memory held by every pool of the world with the ID of its component type
+    [[nodiscard]] std::vector<std::pair<ComponentTypeID, PoolStats>> poolStats() const noexcept
+    {
+        std::vector<std::pair<ComponentTypeID, PoolStats>> stats{};
+        for (std::size_t id = 0; id < m_pools.size(); ++id)
+            if (m_pools[id])
+                stats.emplace_back(static_cast<ComponentTypeID>(id), m_pools[id]->stats());
+        return stats;
+    }
+
+    // Register a component type described at runtime with ComponentInfo::runtime, its pool stores components through the move and destroy functions of the description
+    // Registering a type twice keeps the pool, clear drops it, the type-erased functions below reach the pools of C++ component types as well
+    // and create the pool of a C++ component type used anywhere in the program through the typed functions of a world
+    void registerComponent(const ComponentInfo& info) noexcept
+    {
+        if (info.id >= m_pools.size())
+            m_pools.resize(info.id + 1);
+        if (!m_pools[info.id])
+            m_pools[info.id] = std::make_unique<ErasedPool>(info, m_arena.get());
+    }
+
+    // Move a component of a type given by ID out of raw memory into an entity, returns false if the entity is dead or already has one
+    // or if the type is neither registered nor has a pool with a single dense component array
+    bool addComponentToEntity(Entity::IDType entityID, ComponentTypeID type, void* component) noexcept
+    {
+        return m_entities.isAlive(entityID) && createPool(type) && m_pools[type]->emplaceRaw(entityID, component);
+    }
+
+    // Remove a component of a type given by ID from an entity, returns false if the entity has none
+    bool removeComponentFromEntity(Entity::IDType entityID, ComponentTypeID type) noexcept
+    {
+        return type < m_pools.size() && m_pools[type] && m_pools[type]->remove(entityID);
+    }
+
+    // Check if an entity has a component of a type given by ID
+    [[nodiscard]] bool entityHasComponent(Entity::IDType entityID, ComponentTypeID type) const noexcept
+    {
+        return type < m_pools.size() && m_pools[type] && m_pools[type]->contains(entityID);
+    }
+
+    // Get a raw pointer to the component of a type given by ID of an entity, if it exists, writes through it are not change tracked
+    [[nodiscard]] std::optional<void*> getComponentOfEntity(Entity::IDType entityID, ComponentTypeID type) noexcept
+    {
+        if (type < m_pools.size() && m_pools[type])
+            if (void* component = m_pools[type]->tryGetRaw(entityID); component != nullptr)
+                return std::optional<void*>{ component };
+        return std::optional<void*>{ std::nullopt };
+    }
+
+    // Get every component of a type given by ID as one raw block, so scripts walk the dense array in bulk instead of per entity
+    // The block is invalidated by adding or removing components of the type
+    [[nodiscard]] ComponentBlock getComponentBlock(ComponentTypeID type) noexcept
+    {
+        return type < m_pools.size() && m_pools[type] ? m_pools[type]->block() : ComponentBlock{};
+    }
+
+    // Give memory back the pools no longer use, arrays less than half full are reallocated to fit and empty sparse pages are freed
+    // The work is split into steps, each reallocates one array or scans a run of sparse pages, a call stops before the first step
+    // that does not fit its budget and the next call carries on where it stopped, so a despawn wave can be reclaimed a slice per tick
+    // A call always runs at least one step so even a zero budget makes progress, an array is reallocated as a whole
+    // so a call can still move one whole array of the largest pool when that array alone is larger than the budget
+    // Returns true once a pass over every pool has finished, spans and pointers into shrunk pools are invalidated
+    bool shrinkToFit(std::size_t byteBudget = std::numeric_limits<std::size_t>::max()) noexcept
+    {
+        ShrinkBudget budget{ byteBudget, false };
+        for (; m_shrinkPool < m_pools.size(); ++m_shrinkPool, m_shrinkStep = 0)
+            if (m_pools[m_shrinkPool] && !m_pools[m_shrinkPool]->shrinkToFit(m_shrinkStep, budget))
+                return false;
+        m_shrinkPool = 0;
+        return true;
+    }
+
+    // Get the arena every pool of the world allocates from
+    [[nodiscard]] std::pmr::memory_resource* memoryResource() const noexcept
+    {
+        return m_arena.get();
+    }
+
+    // Call an observer right after an entity gained a component of a type, from direct adds, bulk adds and command buffer flushes
+    template<ComponentConcept Component>
+    ObserverID onAdd(EntityObserver observer) noexcept
+    {
+        return get<Component>().connectOnAdd(std::move(observer));
+    }
+
+    // Call an observer right before an entity loses a component of a type, the component is still readable
+    template<ComponentConcept Component>
+    ObserverID onRemove(EntityObserver observer) noexcept
+    {
+        return get<Component>().connectOnRemove(std::move(observer));
+    }
+
+    // Call an observer with the entities that gained a component of a type, once per bulk add or command buffer flush
+    template<ComponentConcept Component>
+    ObserverID onAddBatch(BatchObserver observer) noexcept
+    {
+        return get<Component>().connectOnAddBatch(std::move(observer));
+    }
+
+    // Call an observer with the entities that lost a component of a type, once per bulk remove or command buffer flush
+    template<ComponentConcept Component>
+    ObserverID onRemoveBatch(BatchObserver observer) noexcept
+    {
+        return get<Component>().connectOnRemoveBatch(std::move(observer));
+    }
+
+    // Disconnect an observer of a component type
+    template<ComponentConcept Component>
+    void disconnect(ObserverID id) noexcept
+    {
+        get<Component>().disconnect(id);
+    }
+
+    // Add components to many entities at once, components[i] goes to entityIDs[i] and the pool grows only once
+    // Only the first min(entityIDs.size(), components.size()) pairs are added
+    // IDs of destroyed entities and relationships to destroyed parents are skipped, a batch containing any is compacted into a copy first
+    template<ComponentConcept Component>
+    void addComponentsBulk(std::span<const Entity::IDType> entityIDs, std::span<Component> components, BulkPolicy policy = BulkPolicy::Checked) noexcept
+    {
+        const std::size_t count = std::min(entityIDs.size(), components.size());
+        entityIDs = entityIDs.first(count);
+        components = components.first(count);
+        std::size_t index = 0;
+        if (std::ranges::all_of(entityIDs, [this, components, &index](Entity::IDType entityID) noexcept { return accepts(entityID, components[index++]); }))
+        {
+            get<Component>().insert(entityIDs, components, policy);
+            return;
+        }
+
+        std::vector<Entity::IDType> liveIDs{};
+        std::vector<Component> liveComponents{};
+        for (std::size_t i = 0; i < count; ++i)
+            if (accepts(entityIDs[i], components[i]))
+            {
+                liveIDs.push_back(entityIDs[i]);
+                liveComponents.push_back(std::move(components[i]));
+            }
+        get<Component>().insert(liveIDs, liveComponents, policy);
+    }
+
+    // Remove a component from many entities at once, stable removal compacts the pool in a single pass
+    template<ComponentConcept Component>
+    void removeComponentsBulk(std::span<const Entity::IDType> entityIDs, RemovalOrder order = RemovalOrder::SwapAndPop) noexcept
+    {
+        get<Component>().erase(entityIDs, order);
+    }
+
+    // Check if an entity has a specific component
+    template<ComponentConcept Component>
+    [[nodiscard]] bool entityHasComponent(Entity::IDType entityID) const noexcept
+    {
+        const PoolType<Component>* pool = find<Component>();
+        return pool != nullptr && pool->contains(entityID);
+    }
+
+    // Get a pointer to a component of an entity, if it exists, the component counts as changed at the current tick
+    template<PooledComponentConcept Component>
+    [[nodiscard]] std::optional<Component*> getComponentOfEntity(Entity::IDType entityID) noexcept
+    {
+        ComponentPool<Component>& pool = get<Component>();
+        if (Component* component = pool.tryGet(entityID); component != nullptr)
+        {
+            pool.markChanged(entityID);
+            return std::optional<Component*>{ component };
+        }
+        else
+            return std::optional<Component*>{ std::nullopt };
+    }
+
+    // Get a read-only pointer to a component of an entity, if it exists, without counting it as changed
+    template<PooledComponentConcept Component>
+    [[nodiscard]] std::optional<const Component*> readComponentOfEntity(Entity::IDType entityID) const noexcept
+    {
+        if (const ComponentPool<Component>* pool = find<Component>(); pool != nullptr)
+            if (const Component* component = pool->tryGet(entityID); component != nullptr)
+                return std::optional<const Component*>{ component };
+        return std::optional<const Component*>{ std::nullopt };
+    }
+
+    // Get the current tick, components added or changed from now on are stamped with it
+    [[nodiscard]] Tick currentTick() const noexcept { return m_tick; }
+
+    // Advance to the next tick, returns the new current tick
+    Tick advanceTick() noexcept
+    {
+#if ECS_PROFILING
+        m_profiler.endTick();
+#endif
+        for (const std::unique_ptr<SharedPoolBase>& shared : m_sharedPools)
+            if (shared)
+                shared->publish(m_tick);
+        return ++m_tick;
+    }
+
+    // Start tracking which components of a type are added or changed, through getComponentOfEntity, systems or markChanged
+    template<PooledComponentConcept Component>
+    void enableChangeTracking() noexcept
+    {
+        if (!get<Component>().tracksChanges())
+            get<Component>().enableChangeTracking(&m_tick);
+    }
+
+    // Mark the component of an entity as changed at the current tick, for writes through views or component spans
+    template<PooledComponentConcept Component>
+    void markChanged(Entity::IDType entityID) noexcept
+    {
+        get<Component>().markChanged(entityID);
+    }
+
+    // Get a view of the entity IDs and components of a type added or changed after a tick, empty without change tracking
+    template<PooledComponentConcept Component>
+    [[nodiscard]] auto changed(Tick sinceTick) noexcept
+    {
+        ComponentPool<Component>& pool = get<Component>();
+        return std::views::iota(std::size_t{ 0 }, pool.changeTicks().size())
+            | std::views::filter([ticks = pool.changeTicks(), sinceTick](std::size_t slot) noexcept { return ticks[slot] > sinceTick; })
+            | std::views::transform([entities = pool.entities(), components = pool.components()](std::size_t slot) noexcept
+            {
+                return std::pair<Entity::IDType, Component*>{ entities[slot], &components[slot] };
+            });
+    }
+
+    // Let other threads read the components of a type through a seqlock mirror, published by advanceTick at the end of every tick
+    // Starts from the current contents and enables change tracking, which tells every publish what to copy
+    // Writes through views or component spans must be marked changed to reach the mirror, enabling replaces another policy of the pool
+    template<SeqLockComponentConcept Component>
+    const SeqLockPool<Component>& enableSeqLockReads() noexcept
+    {
+        return share<SeqLockPool<Component>, Component>();
+    }
+
+    // Keep the components of a type as of the previous tick next to the live pool, flipped by advanceTick at the end of every tick
+    // Only components changed during a tick are copied, so changes have to be marked as for seqlock reads
+    template<BufferedComponentConcept Component>
+    void enableDoubleBuffering() noexcept
+    {
+        static_cast<void>(share<DoubleBufferedPool<Component>, Component>());
+    }
+
+    // Get the components of a type as of the previous tick, or an empty optional if the type is not double buffered
+    // The frame stays unchanged until the next advanceTick, so it can be read together with the live pool to interpolate
+    template<BufferedComponentConcept Component>
+    [[nodiscard]] std::optional<const PoolFrame<Component>*> getPreviousComponentsView() const noexcept
+    {
+        const ComponentTypeID id = componentTypeID<Component>();
+        if (id >= m_sharedPools.size() || !m_sharedPools[id] || m_sharedPools[id]->policy() != AccessPolicy::DoubleBuffered)
+            return std::optional<const PoolFrame<Component>*>{ std::nullopt };
+        return std::optional<const PoolFrame<Component>*>{ &static_cast<const DoubleBufferedPool<Component>&>(*m_sharedPools[id]).previous() };
+    }
+
+    // Hand the components of a type as of the latest tick to one reader thread through a triple buffer refreshed by advanceTick
+    // Only components changed since a frame was last refreshed are copied, so changes have to be marked as for seqlock reads
+    template<BufferedComponentConcept Component>
+    TripleBufferedPool<Component>& enableTripleBuffering() noexcept
+    {
+        return share<TripleBufferedPool<Component>, Component>();
+    }
+
+    // Stop sharing the components of a type with other threads, no thread may still be reading the copy
+    template<ComponentConcept Component>
+    void disableSharedReads() noexcept
+    {
+        if (const ComponentTypeID id = componentTypeID<Component>(); id < m_sharedPools.size())
+            m_sharedPools[id].reset();
+    }
+
+    // Sort the pool of a component type in place with a comparator of components, for example by spatial cell or Morton code
+    // Iteration then follows the sorted order until components are added or removed, pools owned by a group must not be sorted
+    template<PooledComponentConcept Component, class Compare> requires std::is_nothrow_invocable_r_v<bool, Compare&, const Component&, const Component&>
+    void sort(Compare compare) noexcept
+    {
+        get<Component>().sort(std::move(compare));
+    }
+
+    // Sort the pool of a component type in the order of the pool of another, so joins over both walk them in step
+    // Entities without the other component end up after the others, pools owned by a group must not be sorted
+    template<ComponentConcept Other, PooledComponentConcept Component>
+    void sortAs() noexcept
+    {
+        get<Component>().sortAs(get<Other>().entities());
+    }
+
+    // Get a view of all components of a specific type
+    template<PooledComponentConcept Component>
+    [[nodiscard]] auto getComponentsView() noexcept
+    {
+        return get<Component>().components() | std::views::transform([](Component& component) -> Component* { return &component; });
+    }
+
+    // Get a contiguous span of all components of a specific type, parallel to getEntityIDsWithComponentView
+    template<PooledComponentConcept Component>
+    [[nodiscard]] std::span<Component> getComponentsSpan() noexcept
+    {
+        return get<Component>().components();
+    }
+
+    // Get contiguous spans over every member column of a structure-of-arrays component, parallel to getEntityIDsWithComponentView
+    template<SoAComponentConcept Component>
+    [[nodiscard]] typename SoAPool<Component>::Spans getComponentColumns() noexcept
+    {
+        return get<Component>().columns();
+    }
+
+    // Get a view of all entity IDs that have a specific component
+    template<ComponentConcept Component>
+    [[nodiscard]] auto getEntityIDsWithComponentView() noexcept
+    {
+        return get<Component>().entities();
+    }
+
+    // Apply a system to an entity's component
+    template<class System, class... Args> requires SystemConcept<System, Args...>
+    void applySystem(Entity::IDType entityID, Args&&... args) noexcept
+    {
+        using Component = typename System::ComponentType;
+        ComponentPool<Component>& pool = get<Component>();
+        if (Component* component = pool.tryGet(entityID); component != nullptr)
+        {
+            ECS_PROFILE_ENTITY(System, sizeof(Component));
+            System{}(*component, std::forward<Args>(args)...);
+            pool.markChanged(entityID);
+        }
+    }
+
+    // Apply a multi-component system to an entity's components
+    template<class System, class... Args> requires MultiSystemConcept<System, Args...>
+    void applySystem(Entity::IDType entityID, Args&&... args) noexcept
+    {
+        applyMultiSystem<System>(std::type_identity<typename System::ComponentTypes>{}, entityID, std::forward<Args>(args)...);
+    }
+
+    // Get a view over all entities that have every one of the given component types
+    template<ComponentConcept... Components> requires (sizeof...(Components) != 0)
+    [[nodiscard]] View<Components...> view() noexcept
+    {
+        return View<Components...>{ get<Components>()... };
+    }
+
+    // Create a persistent query over the given component types, with an optional trailing Exclude<...>
+    // The query caches its matches and keeps them updated as components are added and removed
+    template<class... Args>
+    [[nodiscard]] Query<Args...> query() noexcept
+    {
+        return makeQuery(std::type_identity<Query<Args...>>{});
+    }
+
+    // Create a group owning the pools of the given component types, iterating it zips their dense arrays without probing
+    template<PooledComponentConcept... Components> requires (sizeof...(Components) > 1)
+    [[nodiscard]] Group<Components...> group() noexcept
+    {
+        return Group<Components...>{ get<Components>()... };
+    }
+
+    // Create a uniform grid over the positions of a component type, for range and nearest-neighbour queries
+    // Enables change tracking, adds and removes reach the grid as they happen and moved components once update is called
+    template<PlanarComponentConcept Component>
+    [[nodiscard]] SpatialGrid<Component> spatialGrid(float cellSize) noexcept
+    {
+        enableChangeTracking<Component>();
+        return SpatialGrid<Component>{ get<Component>(), m_tick, cellSize };
+    }
+
+    // Apply a system to every component of its type in one pass over the dense component array
+    template<class System, class... Args> requires SystemConcept<System, Args&...>
+    void runSystem(Args&&... args) noexcept
+    {
+        using Component = typename System::ComponentType;
+        ComponentPool<Component>& pool = get<Component>();
+        ECS_PROFILE_SYSTEM(System, TraceAndTotals, pool.size(), pool.size() * sizeof(Component));
+        System system{};
+        for (Component& component : pool.components())
+            system(component, args...);
+        pool.markAllChanged();
+    }
+
+    // Apply several systems of one component type in a single pass, every component goes through the systems in order
+    template<class... Systems, class... Args> requires (sizeof...(Systems) > 1) && (SystemConcept<Systems, Args&...> && ...)
+        && (std::same_as<typename Systems::ComponentType, typename std::tuple_element_t<0, std::tuple<Systems...>>::ComponentType> && ...)
+    void runSystems(Args&&... args) noexcept
+    {
+        using Component = typename std::tuple_element_t<0, std::tuple<Systems...>>::ComponentType;
+        ComponentPool<Component>& pool = get<Component>();
+        ECS_PROFILE_SYSTEM(std::tuple<Systems...>, TraceAndTotals, pool.size(), pool.size() * sizeof(Component));
+        std::tuple<Systems...> systems{};
+        for (Component& component : pool.components())
+            (std::get<Systems>(systems)(component, args...), ...);
+        pool.markAllChanged();
+    }
+
+    // Create the pools of the given component types that don't exist yet, concurrent systems then never race on creating them
+    template<class ComponentTypes>
+    void createPools() noexcept
+    {
+        [this]<class... Components>(std::type_identity<std::tuple<Components...>>) noexcept { (static_cast<void>(get<std::remove_const_t<Components>>()), ...); }(std::type_identity<ComponentTypes>{});
+    }
+
+    // Apply a multi-component system to every entity that has all of its component types
+    template<class System, class... Args> requires MultiSystemConcept<System, Args&...>
+    void runSystem(Args&&... args) noexcept
+    {
+        runMultiSystem<System>(std::type_identity<typename System::ComponentTypes>{}, args...);
+    }
+
+    // Apply a structure-of-arrays system once to the full member columns of its component type
+    template<class System, class... Args> requires SoASystemConcept<System, Args&...>
+    void runSystem(Args&&... args) noexcept
+    {
+        SoAPool<typename System::ComponentType>& pool = get<typename System::ComponentType>();
+        ECS_PROFILE_SYSTEM(System, TraceAndTotals, pool.size(), pool.size() * sizeof(typename System::ComponentType));
+        std::apply([&args...](auto... columns) noexcept { System{}(columns..., args...); }, pool.columns());
+    }
+
+    // Apply a system to every component of its type, splitting the dense component array into chunks run on the thread pool
+    template<class System, class... Args> requires SystemConcept<System, Args&...>
+    void runSystemParallel(Args&&... args) noexcept
+    {
+        using Component = typename System::ComponentType;
+        createPools<SystemComponentsOf<System>>(); // Pools are created on the calling thread, never by a chunk running on a worker
+        ComponentPool<Component>& pool = get<Component>();
+        const std::span<Component> components = pool.components();
+        ECS_PROFILE_SYSTEM(System, TraceAndTotals, components.size(), components.size_bytes());
+        threadPool().parallelFor(components.size(), parallelChunkSize(components.size()), [ECS_PROFILE_CAPTURE components, &args...](std::size_t begin, std::size_t end) noexcept
+        {
+            ECS_PROFILE_SYSTEM(System, Trace, end - begin, (end - begin) * sizeof(Component));
+            System system{};
+            for (Component& component : components.subspan(begin, end - begin))
+                system(component, args...);
+        });
+        pool.markAllChanged();
+    }
+
+    // Apply a multi-component system to its joined view, splitting the driving pool into chunks run on the thread pool
+    template<class System, class... Args> requires MultiSystemConcept<System, Args&...>
+    void runSystemParallel(Args&&... args) noexcept
+    {
+        createPools<SystemComponentsOf<System>>();
+        runMultiSystemParallel<System>(std::type_identity<typename System::ComponentTypes>{}, args...);
+    }
+
+    // Apply a structure-of-arrays system to chunks of the member columns of its component type on the thread pool
+    template<class System, class... Args> requires SoASystemConcept<System, Args&...>
+    void runSystemParallel(Args&&... args) noexcept
+    {
+        createPools<SystemComponentsOf<System>>();
+        SoAPool<typename System::ComponentType>& pool = get<typename System::ComponentType>();
+        const typename SoAPool<typename System::ComponentType>::Spans columns = pool.columns();
+        ECS_PROFILE_SYSTEM(System, TraceAndTotals, pool.size(), pool.size() * sizeof(typename System::ComponentType));
+        threadPool().parallelFor(pool.size(), parallelChunkSize(pool.size()), [ECS_PROFILE_CAPTURE &columns, &args...](std::size_t begin, std::size_t end) noexcept
+        {
+            ECS_PROFILE_SYSTEM(System, Trace, end - begin, (end - begin) * sizeof(typename System::ComponentType));
+            std::apply([begin, end, &args...](auto... columns) noexcept { System{}(columns.subspan(begin, end - begin)..., args...); }, columns);
+        });
+    }
+
+    // Run an async system as one coroutine per component of its type, every coroutine gets a copy of its component
+    // The call returns once they are queued on the thread pool, their writes are replayed by flushCommands after they suspend or return
+    // The world must outlive them, waitForAsyncSystems blocks until every one has returned
+    template<class System, class... Args> requires AsyncSystemConcept<System, Args&...>
+    void runAsyncSystem(Args&&... args) noexcept
+    {
+        using Component = typename System::ComponentType;
+        ComponentPool<Component>& pool = get<Component>();
+        const std::shared_ptr<System> system = std::make_shared<System>();
+        for (std::size_t slot = 0; slot < pool.size(); ++slot)
+            startAsyncSystem(system, pool.entities()[slot], pool.components()[slot], args...);
+    }
+
+    // Run an async system as a coroutine on a copy of the component of one entity, returns false if the entity has none
+    template<class System, class... Args> requires AsyncSystemConcept<System, Args&...>
+    bool applyAsyncSystem(Entity::IDType entityID, Args&&... args) noexcept
+    {
+        using Component = typename System::ComponentType;
+        if (const Component* component = get<Component>().tryGet(entityID); component != nullptr)
+        {
+            startAsyncSystem(std::make_shared<System>(), entityID, *component, args...);
+            return true;
+        }
+        return false;
+    }
+
+    // Get the number of async system coroutines started and not yet returned
+    [[nodiscard]] std::size_t asyncSystemsInFlight() const noexcept
+    {
+        return m_async->inFlight();
+    }
+
+    // Help the thread pool until every async system coroutine has returned, then replay what they recorded
+    void waitForAsyncSystems() noexcept
+    {
+        m_async->wait();
+        flushCommands();
+    }
+
+    // Attach an entity to a parent in the hierarchy, or make it a root with Relationship::None
+    // Returns false if it would make a cycle or if the entity or the parent is not alive
+    bool setParent(Entity::IDType entityID, Entity::IDType parentID) noexcept
+    {
+        if (!m_entities.isAlive(entityID) || (parentID != Relationship::None && !m_entities.isAlive(parentID)))
+            return false;
+        return get<Relationship>().setParent(entityID, parentID);
+    }
+
+    // Get the hierarchy of the world, its entities are sorted so every parent comes before its children
+    [[nodiscard]] const HierarchyPool& hierarchy() noexcept
+    {
+        return get<Relationship>();
+    }
+
+    // Create an entity with a fresh or recycled generational ID, its ID is Entity::Invalid once every index is taken
+    [[nodiscard]] Entity createEntity() noexcept
+    {
+        return m_entities.create();
+    }
+
+    // Remove every component of an entity from every pool of the world and release its ID
+    void destroyEntity(Entity::IDType entityID) noexcept
+    {
+        for (const std::unique_ptr<PoolBase>& pool : m_pools)
+            if (pool)
+                pool->remove(entityID);
+        m_entities.destroy(entityID);
+    }
+
+    // Make a specific entity ID alive, for replicas that mirror the entities of another world instead of creating their own
+    // A live entity of another generation at the same index is replaced, its components stay until they are removed
+    bool adoptEntity(Entity::IDType entityID) noexcept
+    {
+        return m_entities.adopt(entityID);
+    }
+
+    // Check if an entity was created by the world and not destroyed since
+    [[nodiscard]] bool isAlive(Entity::IDType entityID) const noexcept
+    {
+        return m_entities.isAlive(entityID);
+    }
+
+    // Get the command buffer of the calling thread, every thread outside the thread pool gets its own buffer on first use
+    // Workers index their buffer directly, other threads look it up once under a lock and then hit a thread-local cache
+    [[nodiscard]] CommandBuffer& commands() noexcept
+    {
+        if (const std::size_t worker = threadPool().workerIndex(); worker < m_commandBuffers.size())
+            return *m_commandBuffers[worker];
+        if (t_outsideBuffer.world == m_serial)
+            return *t_outsideBuffer.buffer;
+
+        std::lock_guard lock{ m_outsideMutex };
+        const std::thread::id thread = std::this_thread::get_id();
+        auto found = std::ranges::find(m_outsideBuffers, thread, &OutsideBuffer::first);
+        if (found == m_outsideBuffers.end())
+            found = m_outsideBuffers.insert(m_outsideBuffers.end(), OutsideBuffer{ thread, std::make_unique<CommandBuffer>() });
+        t_outsideBuffer = CachedBuffer{ m_serial, found->second.get() };
+        return *found->second;
+    }
+
+    // Replay the command buffers of every thread and those handed over by async systems in one batch sorted by component type
+    // Destroys are replayed last
+    void flushCommands() noexcept
+    {
+        std::vector<std::unique_ptr<CommandBuffer>> async = m_async->take();
+        std::vector<CommandBuffer*> buffers{};
+        for (const std::unique_ptr<CommandBuffer>& buffer : m_commandBuffers)
+            buffers.push_back(buffer.get());
+        {
+            std::lock_guard lock{ m_outsideMutex };
+            for (const OutsideBuffer& buffer : m_outsideBuffers)
+                buffers.push_back(buffer.second.get());
+        }
+        for (const std::unique_ptr<CommandBuffer>& buffer : async)
+            buffers.push_back(buffer.get());
+        flushCommands(buffers);
+        m_async->recycle(std::move(async));
+    }
+
+    // Replay command buffers in one batch sorted by component type, the recording order is kept per type
+    void flushCommands(std::span<CommandBuffer* const> buffers) noexcept
+    {
+        using Command = CommandBuffer::Command;
+        using CommandKind = CommandBuffer::CommandKind;
+
+        m_commandBatch.clear();
+        for (const CommandBuffer* buffer : buffers)
+            for (const Command& command : buffer->commands())
+            {
+                const bool deadParent = command.kind == CommandKind::Add && command.type == componentTypeID<Relationship>()
+                    && !accepts(command.entityID, *static_cast<const Relationship*>(command.component));
+                if ((command.kind == CommandKind::Add || command.kind == CommandKind::Set) && (deadParent || !m_entities.isAlive(command.entityID)))
+                    command.discard(command.component);
+                else
+                    m_commandBatch.push_back(command);
+            }
+        std::ranges::stable_sort(m_commandBatch, {}, &Command::type);
+
+        // Batch observers get every entity of the flush at once, pools created by the flush have no observers yet
+        for (const std::unique_ptr<PoolBase>& pool : m_pools)
+            if (pool)
+                pool->beginBatch();
+        const std::size_t batchedPools = m_pools.size();
+
+        // Replay runs of commands with the same type and kind so every pool is touched once per run
+        for (std::size_t begin = 0; begin < m_commandBatch.size();)
+        {
+            const Command& first = m_commandBatch[begin];
+            std::size_t end = begin + 1;
+            while (end < m_commandBatch.size() && m_commandBatch[end].type == first.type && m_commandBatch[end].kind == first.kind)
+                ++end;
+
+            const std::span<const Command> run = std::span<const Command>{ m_commandBatch }.subspan(begin, end - begin);
+            if (first.kind == CommandKind::Destroy)
+                for (const Command& command : run)
+                    destroyEntity(command.entityID);
+            else if (first.kind == CommandKind::Add || first.kind == CommandKind::Set)
+            {
+                if (first.type >= m_pools.size())
+                    m_pools.resize(first.type + 1);
+                if (!m_pools[first.type])
+                    m_pools[first.type] = first.makePool(m_arena.get());
+                first.apply(*m_pools[first.type], run);
+            }
+            else if (first.type < m_pools.size() && m_pools[first.type])
+                for (const Command& command : run)
+                    m_pools[first.type]->remove(command.entityID);
+            begin = end;
+        }
+
+        for (std::size_t i = 0; i < batchedPools; ++i)
+            if (m_pools[i])
+                m_pools[i]->endBatch();
+
+        for (CommandBuffer* buffer : buffers)
+            buffer->release();
+        m_commandBatch.clear();
+    }
+
+    // Destroy every pool and entity of the world at once, together with the mirrors other threads read
+    void clear() noexcept
+    {
+        m_sharedPools.clear();
+        m_pools.clear();
+        m_arena->release();
+        m_entities = EntityRegistry{};
+        m_shrinkPool = 0;
+        m_shrinkStep = 0;
+    }
+
+    // Save the entities and the pools of the given component types as a binary snapshot, returns false if the file can't be written
+    // Every pool is written as its raw dense arrays, components are stored with their in-memory layout
+    template<SnapshotComponentConcept... Components>
+    bool saveSnapshot(const char* path) const noexcept
+    {
+        std::FILE* file = std::fopen(path, "wb");
+        if (!file)
+            return false;
+
+        Snapshot::Writer writer{ file };
+        const Snapshot::Header header{ .poolCount = sizeof...(Components), .slotCount = m_entities.slots().size(), .freeHead = m_entities.freeHead() };
+        writer.write(std::span{ &header, 1 });
+        writer.write(m_entities.slots());
+        const bool written = (writePool<Components>(writer) && ...);
+        return std::fclose(file) == 0 && written;
+    }
+
+    // Load a snapshot saved with the same component types in the same order, replacing the entities and the pools of those types
+    // The file is memory-mapped and its blocks are copied straight into the pools, returns false and changes nothing if it doesn't match
+    // or is damaged, pools of other types only lose the components of entities the snapshot doesn't keep alive
+    // Observers of the listed pools are not notified, so queries and groups over them must be dropped before and created again after,
+    // and their shared reads are disabled
+    template<SnapshotComponentConcept... Components>
+    bool loadSnapshot(const char* path) noexcept
+    {
+        const MappedFile file{ path };
+        Snapshot::Reader reader{ file.bytes() };
+        const std::optional<std::span<const Snapshot::Header>> header = reader.take<Snapshot::Header>(1);
+        if (!header || (*header)[0].magic != Snapshot::Magic || (*header)[0].version != Snapshot::Version
+            || (*header)[0].indexBits != Entity::IndexBits || (*header)[0].poolCount != sizeof...(Components))
+            return false;
+
+        const std::optional<std::span<const Entity::IDType>> slots = reader.take<Entity::IDType>((*header)[0].slotCount);
+        if (!slots)
+            return false;
+
+        // Check every block before touching the world so a damaged snapshot leaves it unchanged
+        std::optional<EntityRegistry> entities = EntityRegistry::restore(*slots, (*header)[0].freeHead);
+        if (!entities)
+            return false;
+        std::tuple<std::pair<std::span<const Entity::IDType>, std::span<const Components>>...> pools{};
+        if (!(readPool<Components>(reader, *entities, std::get<std::pair<std::span<const Entity::IDType>, std::span<const Components>>>(pools)) && ...))
+            return false;
+
+        const std::array<ComponentTypeID, sizeof...(Components)> listed{ componentTypeID<Components>()... };
+        const std::span<const Entity::IDType> current = m_entities.slots();
+        for (std::size_t index = 0; index < current.size(); ++index)
+            if (Entity::indexOf(current[index]) == index && !entities->isAlive(current[index]))
+                for (ComponentTypeID id = 0; id < m_pools.size(); ++id)
+                    if (m_pools[id] && std::ranges::find(listed, id) == listed.end())
+                        m_pools[id]->remove(current[index]);
+
+        m_entities = std::move(*entities);
+        (disableSharedReads<Components>(), ...);
+        (get<Components>().assign(std::get<std::pair<std::span<const Entity::IDType>, std::span<const Components>>>(pools).first,
+            std::get<std::pair<std::span<const Entity::IDType>, std::span<const Components>>>(pools).second), ...);
+
+        // The replaced pools start a new shrink pass, a step cursor of their old arrays means nothing for the loaded ones
+        m_shrinkPool = 0;
+        m_shrinkStep = 0;
+        return true;
+    }
+
+#if ECS_PROFILING
+    // Get the profiler recording the system runs of the world
+    [[nodiscard]] Profiler& profiler() noexcept
+    {
+        return m_profiler;
+    }
+#endif
+
+    // Get the thread pool shared by the parallel system runners of every world
+    [[nodiscard]] static ThreadPool& threadPool() noexcept
+    {
+        static ThreadPool instance{};
+        return instance;
+    }
+
+private:
+    // Get the number of elements per parallel job, a few jobs per thread to leave room for stealing
+    [[nodiscard]] static std::size_t parallelChunkSize(std::size_t count) noexcept
+    {
+        static constexpr std::size_t MinChunkSize = 1024;
+        return std::max(MinChunkSize, count / ((threadPool().threadCount() + 1) * 4));
+    }
+
+    // Unpack the component types of a multi-component system and apply it to one entity
+    template<class System, class... Components, class... Args>
+    void applyMultiSystem(std::type_identity<std::tuple<Components...>>, Entity::IDType entityID, Args&&... args) noexcept
+    {
+        if ((get<std::remove_const_t<Components>>().contains(entityID) && ...))
+        {
+            ECS_PROFILE_ENTITY(System, (sizeof(Components) + ...));
+            System{}(get<std::remove_const_t<Components>>().get(entityID)..., std::forward<Args>(args)...);
+            (markWritten<Components>(get<std::remove_const_t<Components>>(), entityID), ...);
+        }
+    }
+
+    // Mark the component of an entity as changed if a system declared write access to its type, tags have no state to change
+    template<class Component>
+    static void markWritten(PoolType<std::remove_const_t<Component>>& pool, Entity::IDType entityID) noexcept
+    {
+        if constexpr (!std::is_const_v<Component> && !TagComponentConcept<std::remove_const_t<Component>>)
+            pool.markChanged(entityID);
+    }
+
+    // Unpack the component types of a multi-component system and apply it to the joined view
+    template<class System, class... Components, class... Args>
+    void runMultiSystem(std::type_identity<std::tuple<Components...>>, Args&... args) noexcept
+    {
+        const View<std::remove_const_t<Components>...> joined = view<std::remove_const_t<Components>...>();
+        ECS_PROFILE_SYSTEM(System, TraceAndTotals, joined.sizeHint(), joined.sizeHint() * (sizeof(Components) + ...));
+        System system{};
+        const std::tuple<PoolType<std::remove_const_t<Components>>*...> pools{ &get<std::remove_const_t<Components>>()... };
+        joined.each([&system, &pools, &args...](Entity::IDType entityID, Components&... components) noexcept
+        {
+            system(components..., args...);
+            (markWritten<Components>(*std::get<PoolType<std::remove_const_t<Components>>*>(pools), entityID), ...);
+        });
+    }
+
+    // Unpack the component types of a multi-component system and apply it to the joined view in parallel chunks
+    template<class System, class... Components, class... Args>
+    void runMultiSystemParallel(std::type_identity<std::tuple<Components...>>, Args&... args) noexcept
+    {
+        const View<std::remove_const_t<Components>...> joined = view<std::remove_const_t<Components>...>();
+        const std::tuple<PoolType<std::remove_const_t<Components>>*...> pools{ &get<std::remove_const_t<Components>>()... };
+        ECS_PROFILE_SYSTEM(System, TraceAndTotals, joined.sizeHint(), joined.sizeHint() * (sizeof(Components) + ...));
+        threadPool().parallelFor(joined.sizeHint(), parallelChunkSize(joined.sizeHint()), [ECS_PROFILE_CAPTURE &joined, &pools, &args...](std::size_t begin, std::size_t end) noexcept
+        {
+            ECS_PROFILE_SYSTEM(System, Trace, end - begin, (end - begin) * (sizeof(Components) + ...));
+            System system{};
+            joined.each(begin, end, [&system, &pools, &args...](Entity::IDType entityID, Components&... components) noexcept
+            {
+                system(components..., args...);
+                (markWritten<Components>(*std::get<PoolType<std::remove_const_t<Components>>*>(pools), entityID), ...);
+            });
+        });
+    }
+
+    // Write the pool header and the dense arrays of a component type, an absent pool is written as empty
+    template<SnapshotComponentConcept Component>
+    bool writePool(Snapshot::Writer& writer) const noexcept
+    {
+        const ComponentPool<Component>* pool = find<Component>();
+        const Snapshot::PoolHeader header{ .count = pool ? pool->size() : 0, .componentSize = sizeof(Component), .componentAlignment = alignof(Component) };
+        return writer.write(std::span{ &header, 1 })
+            && writer.write(pool ? pool->entities() : std::span<const Entity::IDType>{})
+            && writer.write(pool ? pool->components() : std::span<const Component>{});
+    }
+
+    // Read the pool header and the dense arrays of a component type, returns false if the layout doesn't match
+    // or an entity ID is not alive in the restored registry or appears twice
+    template<SnapshotComponentConcept Component>
+    static bool readPool(Snapshot::Reader& reader, const EntityRegistry& entities, std::pair<std::span<const Entity::IDType>, std::span<const Component>>& pool) noexcept
+    {
+        const std::optional<std::span<const Snapshot::PoolHeader>> header = reader.take<Snapshot::PoolHeader>(1);
+        if (!header || (*header)[0].componentSize != sizeof(Component) || (*header)[0].componentAlignment != alignof(Component))
+            return false;
+
+        const std::optional<std::span<const Entity::IDType>> entityIDs = reader.take<Entity::IDType>((*header)[0].count);
+        const std::optional<std::span<const Component>> components = entityIDs ? reader.take<Component>((*header)[0].count) : std::nullopt;
+        if (!components)
+            return false;
+
+        std::vector<bool> seen(entities.slots().size());
+        for (const Entity::IDType entityID : *entityIDs)
+        {
+            if (!entities.isAlive(entityID) || seen[Entity::indexOf(entityID)])
+                return false;
+            seen[Entity::indexOf(entityID)] = true;
+        }
+
+        pool = { *entityIDs, *components };
+        return true;
+    }
+
+    // Start the coroutine of an async system, its context keeps the system object alive since the coroutine may outlive the call
+    template<class System, class Component, class... Args>
+    void startAsyncSystem(const std::shared_ptr<System>& system, Entity::IDType entityID, const Component& component, Args&... args) noexcept
+    {
+        std::unique_ptr<AsyncContext> context = std::make_unique<AsyncContext>(*m_async, system);
+        AsyncTask task = (*system)(entityID, Component{ component }, *context, args...);
+        task.start(std::move(context));
+    }
+
+    // Attach a copy of the pool of a component type for other threads, replacing one with another access policy
+    template<class Shared, PooledComponentConcept Component>
+    [[nodiscard]] Shared& share() noexcept
+    {
+        enableChangeTracking<Component>();
+        const ComponentTypeID id = componentTypeID<Component>();
+        if (id >= m_sharedPools.size())
+            m_sharedPools.resize(id + 1);
+        if (!m_sharedPools[id] || m_sharedPools[id]->policy() != Shared::Policy)
+        {
+            m_sharedPools[id].reset();
+            m_sharedPools[id] = std::make_unique<Shared>(get<Component>());
+            m_sharedPools[id]->publish(m_tick - 1);
+        }
+        return static_cast<Shared&>(*m_sharedPools[id]);
+    }
+
+    // Construct a query in place from the pools of its component types
+    template<ComponentConcept... Components, ComponentConcept... Excluded>
+    [[nodiscard]] CachedQuery<std::tuple<Components...>, Exclude<Excluded...>> makeQuery(std::type_identity<CachedQuery<std::tuple<Components...>, Exclude<Excluded...>>>) noexcept
+    {
+        return CachedQuery<std::tuple<Components...>, Exclude<Excluded...>>{ get<Components>()..., get<Excluded>()... };
+    }
+
+    // Get the pool of components for a specific type, creating it on first use
+    template<ComponentConcept Component>
+    [[nodiscard]] PoolType<Component>& get() noexcept
+    {
+        static_cast<void>(PoolFactoryRegistered<Component>); // Lets the functions taking a type ID create the pool as well
+        const ComponentTypeID id = componentTypeID<Component>();
+        if (id >= m_pools.size())
+            m_pools.resize(id + 1);
+        if (!m_pools[id])
+            m_pools[id] = std::make_unique<PoolType<Component>>(m_arena.get());
+        return static_cast<PoolType<Component>&>(*m_pools[id]);
+    }
+
+    // Create the pool of a type given by ID from the factory of its C++ component type if there is none yet
+    // Returns false if the type has no pool and is no C++ component type, a runtime type needs registerComponent first
+    bool createPool(ComponentTypeID type) noexcept
+    {
+        if (type < m_pools.size() && m_pools[type])
+            return true;
+
+        const std::vector<PoolFactory>& factories = poolFactories();
+        const auto factory = std::ranges::find(factories, type, [](const PoolFactory& candidate) noexcept { return *candidate.id; });
+        if (factory == factories.end())
+            return false;
+
+        if (type >= m_pools.size())
+            m_pools.resize(type + 1);
+        m_pools[type] = factory->create(m_arena.get());
+        return true;
+    }
+
+    // Check if a component may be added to an entity, the entity and the parent of a relationship have to be alive
+    template<ComponentConcept Component>
+    [[nodiscard]] bool accepts(Entity::IDType entityID, const Component& component) const noexcept
+    {
+        if constexpr (std::same_as<Component, Relationship>)
+            if (component.parent != Relationship::None && !m_entities.isAlive(component.parent))
+                return false;
+        return m_entities.isAlive(entityID);
+    }
+
+    // Get the pool of components for a specific type, or nullptr if the world never stored one
+    template<ComponentConcept Component>
+    [[nodiscard]] const PoolType<Component>* find() const noexcept
+    {
+        const ComponentTypeID id = componentTypeID<Component>();
+        return id < m_pools.size() ? static_cast<const PoolType<Component>*>(m_pools[id].get()) : nullptr;
+    }
+
+    std::unique_ptr<std::pmr::unsynchronized_pool_resource> m_arena{}; // Declared first so it outlives every pool
+    std::vector<std::unique_ptr<PoolBase>> m_pools{}; // Pools indexed by component type ID
+    std::vector<std::unique_ptr<SharedPoolBase>> m_sharedPools{}; // Copies other threads read, indexed by component type ID, declared after the pools they observe
+    EntityRegistry m_entities{};
+    Tick m_tick{ 1 };
+    // Command buffer of a thread outside the thread pool, keyed by thread
+    using OutsideBuffer = std::pair<std::thread::id, std::unique_ptr<CommandBuffer>>;
+
+    // Last outside buffer a thread looked up, worlds are told apart by serial since a new world may reuse the address of a destroyed one
+    struct CachedBuffer final
+    {
+        std::uint64_t world{};
+        CommandBuffer* buffer{};
+    };
+
+    // Get a serial no other world of the process has, 0 is never handed out
+    [[nodiscard]] static std::uint64_t nextSerial() noexcept
+    {
+        static std::atomic<std::uint64_t> counter{};
+        return counter.fetch_add(1, std::memory_order_relaxed) + 1;
+    }
+
+    static inline thread_local CachedBuffer t_outsideBuffer{ 0, nullptr };
+
+    std::vector<std::unique_ptr<CommandBuffer>> m_commandBuffers{}; // Command buffer of every worker, indexed by worker index
+    std::vector<OutsideBuffer> m_outsideBuffers{};
+    std::mutex m_outsideMutex{}; // Guards the outside buffers
+    std::uint64_t m_serial{ nextSerial() };
+    std::vector<CommandBuffer::Command> m_commandBatch{}; // Merged commands of a flush, keeps its capacity across ticks
+    std::unique_ptr<AsyncSystemQueue> m_async{ std::make_unique<AsyncSystemQueue>(threadPool()) };
+    std::size_t m_shrinkPool{}; // Pool the next shrinkToFit call carries on with
+    std::size_t m_shrinkStep{}; // Step of that pool the next call carries on with
+#if ECS_PROFILING
+    Profiler m_profiler{ threadPool().threadCount() };
+#endif
+};
+
+// Compact encoding shared by delta encoders and decoders
+// Entity IDs and counts are LEB128 varints, components are XORed with their baseline and only the non-zero bytes are sent
+struct DeltaCodec final
+{
+    // Append an unsigned integer as a varint, 7 bits per byte with the high bit marking that more bytes follow
+    static void writeVarint(std::vector<std::uint8_t>& out, std::uint64_t value) noexcept
+    {
+        for (; value >= 0x80; value >>= 7)
+            out.push_back(static_cast<std::uint8_t>(value | 0x80));
+        out.push_back(static_cast<std::uint8_t>(value));
+    }
+
+    // Read a varint at an offset, advancing it, or an empty optional if the input ends or the varint is too long
+    [[nodiscard]] static std::optional<std::uint64_t> readVarint(std::span<const std::uint8_t> in, std::size_t& offset) noexcept
+    {
+        std::uint64_t value = 0;
+        for (unsigned shift = 0; shift < 64 && offset < in.size(); shift += 7)
+        {
+            const std::uint8_t byte = in[offset++];
+            value |= std::uint64_t{ byte & 0x7fu } << shift;
+            if ((byte & 0x80) == 0)
+                return value;
+        }
+        return std::nullopt;
+    }
+
+    // Append the XOR of a value with its baseline as a bitmask of changed bytes followed by those bytes, returns false if no byte changed
+    template<std::size_t Size>
+    static bool writeXor(std::vector<std::uint8_t>& out, const std::array<std::uint8_t, Size>& value, const std::array<std::uint8_t, Size>& baseline) noexcept
+    {
+        const std::size_t maskOffset = out.size();
+        out.resize(out.size() + (Size + 7) / 8);
+        bool changed = false;
+        for (std::size_t i = 0; i < Size; ++i)
+            if (value[i] != baseline[i])
+            {
+                out[maskOffset + i / 8] |= static_cast<std::uint8_t>(1u << (i % 8));
+                out.push_back(value[i] ^ baseline[i]);
+                changed = true;
+            }
+        return changed;
+    }
+
+    // Apply an XOR written by writeXor to a baseline at an offset, advancing it, returns false if the input ends
+    template<std::size_t Size>
+    [[nodiscard]] static bool readXor(std::span<const std::uint8_t> in, std::size_t& offset, std::array<std::uint8_t, Size>& baseline) noexcept
+    {
+        constexpr std::size_t MaskSize = (Size + 7) / 8;
+        if (in.size() - offset < MaskSize)
+            return false;
+
+        const std::span<const std::uint8_t> mask = in.subspan(offset, MaskSize);
+        offset += MaskSize;
+        for (std::size_t i = 0; i < Size; ++i)
+            if (mask[i / 8] & (1u << (i % 8)))
+            {
+                if (offset == in.size())
+                    return false;
+                baseline[i] ^= in[offset++];
+            }
+        return true;
+    }
+};
+
+// Encoder of the changes of a world since the last encoded tick, for streaming the world to replicas
+// For every component type in order: the removed entity IDs, then the added or changed entity IDs with their XORed components
+// The encoder keeps the last sent value of every component as the baseline, replicas keep it as their own components
+// An encoder must be destroyed before its world is cleared or destroyed
+template<SnapshotComponentConcept... Components>
+class DeltaEncoder final
+{
+public:
+    explicit DeltaEncoder(World& world) noexcept : m_world{ world }
+    {
+        (world.enableChangeTracking<Components>(), ...);
+        ((std::get<Removals<Components>>(m_removals).observer = world.onRemoveBatch<Components>([this](std::span<const Entity::IDType> entityIDs)
+        {
+            std::vector<Entity::IDType>& removed = std::get<Removals<Components>>(m_removals).entityIDs;
+            removed.insert(removed.end(), entityIDs.begin(), entityIDs.end());
+        })), ...);
+    }
+
+    DeltaEncoder(const DeltaEncoder&) = delete;
+    DeltaEncoder(DeltaEncoder&&) = delete;
+    DeltaEncoder& operator=(const DeltaEncoder&) = delete;
+    DeltaEncoder& operator=(DeltaEncoder&&) = delete;
+
+    ~DeltaEncoder() noexcept
+    {
+        (m_world.disconnect<Components>(std::get<Removals<Components>>(m_removals).observer), ...);
+    }
+
+    // Encode every change since the previous call into a packet, the first call sends everything, advancing the world is left to the caller
+    // Components stamped at the current tick are looked at again by the next call since they may still change, unchanged bytes are not resent
+    // The packet is cleared first, reusing one packet across ticks avoids allocations
+    void encode(std::vector<std::uint8_t>& packet) noexcept
+    {
+        packet.clear();
+        (encodePool<Components>(packet), ...);
+        m_sinceTick = m_world.currentTick() - 1;
+    }
+
+private:
+    template<class Component>
+    struct Removals final
+    {
+        std::vector<Entity::IDType> entityIDs{}; // Entities that lost the component since the last encode
+        ObserverID observer{};
+    };
+
+    template<SnapshotComponentConcept Component>
+    void encodePool(std::vector<std::uint8_t>& packet) noexcept
+    {
+        using Bytes = std::array<std::uint8_t, sizeof(Component)>;
+        ComponentPool<Component>& baseline = std::get<ComponentPool<Component>>(m_baseline);
+
+        // Entities that lost the component before a replica ever saw it need no removal
+        std::vector<Entity::IDType>& removed = std::get<Removals<Component>>(m_removals).entityIDs;
+        std::erase_if(removed, [&baseline](Entity::IDType entityID) noexcept { return !baseline.erase(entityID); });
+        DeltaCodec::writeVarint(packet, removed.size());
+        for (const Entity::IDType entityID : removed)
+            DeltaCodec::writeVarint(packet, entityID);
+        removed.clear();
+
+        // Changes are written to the scratch buffer first since unchanged bytes may leave fewer entries than stamped components
+        m_scratch.clear();
+        std::size_t changed = 0;
+        for (const auto [entityID, component] : m_world.changed<Component>(m_sinceTick))
+        {
+            const Bytes value = std::bit_cast<Bytes>(*component);
+            Component* sent = baseline.tryGet(entityID);
+            const std::size_t start = m_scratch.size();
+            DeltaCodec::writeVarint(m_scratch, entityID);
+            if (!DeltaCodec::writeXor(m_scratch, value, sent ? std::bit_cast<Bytes>(*sent) : Bytes{}) && sent)
+            {
+                m_scratch.resize(start);
+                continue;
+            }
+
+            // A new component is sent even when it XORs to nothing, since a replica has to add it
+            if (sent)
+                *sent = *component;
+            else
+                baseline.emplace(entityID, Component{ *component });
+            ++changed;
+        }
+        DeltaCodec::writeVarint(packet, changed);
+        packet.insert(packet.end(), m_scratch.begin(), m_scratch.end());
+    }
+
+    World& m_world;
+    Tick m_sinceTick{}; // Tick before the previous encode, changes after it go into the next packet, every stamped tick is later than 0
+    std::tuple<ComponentPool<Components>...> m_baseline{}; // Last value sent of every component
+    std::tuple<Removals<Components>...> m_removals{};
+    std::vector<std::uint8_t> m_scratch{};
+};
+
+// Decoder applying the packets of a delta encoder with the same component types to a replica world
+// Replicated entities keep their IDs, the replica world adopts every entity a component is added to
+template<SnapshotComponentConcept... Components>
+class DeltaDecoder final
+{
+public:
+    explicit DeltaDecoder(World& world) noexcept : m_world{ world } {}
+
+    // Apply a packet, returns false if it is malformed, the changes decoded before the error stay applied
+    bool decode(std::span<const std::uint8_t> packet) noexcept
+    {
+        std::size_t offset = 0;
+        return (decodePool<Components>(packet, offset) && ...) && offset == packet.size();
+    }
+
+private:
+    template<SnapshotComponentConcept Component>
+    bool decodePool(std::span<const std::uint8_t> packet, std::size_t& offset) noexcept
+    {
+        using Bytes = std::array<std::uint8_t, sizeof(Component)>;
+
+        const std::optional<std::uint64_t> removed = DeltaCodec::readVarint(packet, offset);
+        if (!removed)
+            return false;
+        for (std::uint64_t i = 0; i < *removed; ++i)
+        {
+            const std::optional<std::uint64_t> entityID = DeltaCodec::readVarint(packet, offset);
+            if (!entityID)
+                return false;
+            m_world.removeComponentFromEntity<Component>(static_cast<Entity::IDType>(*entityID));
+        }
+
+        const std::optional<std::uint64_t> changed = DeltaCodec::readVarint(packet, offset);
+        if (!changed)
+            return false;
+        for (std::uint64_t i = 0; i < *changed; ++i)
+        {
+            const std::optional<std::uint64_t> entityID = DeltaCodec::readVarint(packet, offset);
+            if (!entityID)
+                return false;
+
+            const Entity::IDType id = static_cast<Entity::IDType>(*entityID);
+            const std::optional<Component*> current = m_world.getComponentOfEntity<Component>(id);
+            Bytes value = current ? std::bit_cast<Bytes>(**current) : Bytes{};
+            if (!DeltaCodec::readXor(packet, offset, value))
+                return false;
+
+            if (current)
+                **current = std::bit_cast<Component>(value);
+            else if (m_world.adoptEntity(id))
+                m_world.addComponentToEntity(id, std::bit_cast<Component>(value));
+        }
+        return true;
+    }
+
+    World& m_world;
+};
+
+// Scheduler running systems concurrently when their component access sets don't conflict
+class Scheduler final
+{
+public:
+    // Add a system with the arguments it is run with, it runs after every earlier system it conflicts with
+    template<class System, class... Args> requires SystemConcept<System, Args&...> || MultiSystemConcept<System, Args&...>
+    Scheduler& add(Args... args) noexcept
+    {
+        SystemAccess access = SystemAccessOf<System>::get();
+
+        std::size_t wave = 0;
+        for (const Entry& entry : m_entries)
+            if (entry.access.conflictsWith(access))
+                wave = std::max(wave, entry.wave + 1);
+
+        m_entries.push_back(Entry{ [... args = std::move(args)](World& world) mutable noexcept { world.runSystem<System>(args...); },
+            [](World& world) noexcept { world.createPools<SystemComponentsOf<System>>(); }, std::move(access), wave });
+        if (wave >= m_waves.size())
+            m_waves.resize(wave + 1);
+        m_waves[wave].push_back(m_entries.size() - 1);
+        return *this;
+    }
+
+    // Run every system on a world, the systems of one wave run concurrently and waves run one after another
+    void run(World& world) noexcept
+    {
+        ThreadPool& pool = World::threadPool();
+        for (const std::vector<std::size_t>& wave : m_waves)
+        {
+            // Systems of one wave create no pools concurrently when every pool they touch exists before the wave starts
+            for (const std::size_t index : wave)
+                m_entries[index].createPools(world);
+
+            ThreadPool::Counter counter{};
+            for (const std::size_t index : wave)
+                pool.submit([this, index, &world]() noexcept { m_entries[index].run(world); }, counter);
+            pool.wait(counter);
+        }
+    }
+
+private:
+    struct Entry final
+    {
+        std::function<void(World&)> run{};
+        void (*createPools)(World& world) noexcept {}; // Create the pools the system touches, called before its wave runs
+        SystemAccess access{};
+        std::size_t wave{};
+    };
+
+    std::vector<Entry> m_entries{};
+    std::vector<std::vector<std::size_t>> m_waves{}; // Indices of the entries run together, in order
+};
+
+// Pair of systems whose adjacent runs can share one pass over the pool of their common single component type
+template<class First, class Second>
+inline constexpr bool FusesWith = false;
+
+template<class First, class Second> requires requires { typename First::ComponentType; typename Second::ComponentType; }
+    && (!requires { typename First::ComponentTypes; }) && (!requires { typename Second::ComponentTypes; })
+    && std::same_as<typename First::ComponentType, typename Second::ComponentType> && (!SoAComponentConcept<typename First::ComponentType>)
+inline constexpr bool FusesWith<First, Second> = true;
+
+// Static schedule of a pipeline, systems are fused into stages and stages are ordered into waves of conflict-free stages
+template<std::size_t SystemCount>
+struct PipelineSchedule final
+{
+    std::array<std::size_t, SystemCount + 1> stageBegin{}; // First system of every stage, the last entry ends the last stage
+    std::size_t stageCount{};
+    std::array<std::size_t, SystemCount> stageOrder{}; // Stages sorted by wave
+    std::array<std::size_t, SystemCount + 1> waveBegin{}; // First entry of stageOrder of every wave, the last entry ends the last wave
+    std::size_t waveCount{};
+};
+
+// Build the schedule of a pipeline from which systems fuse with their predecessor and which pairs of systems conflict
+template<std::size_t SystemCount>
+[[nodiscard]] constexpr PipelineSchedule<SystemCount> makePipelineSchedule(const std::array<bool, SystemCount>& fuses,
+    const std::array<std::array<bool, SystemCount>, SystemCount>& conflicts) noexcept
+{
+    PipelineSchedule<SystemCount> schedule{};
+    for (std::size_t system = 0; system < SystemCount; ++system)
+        if (system == 0 || !fuses[system])
+            schedule.stageBegin[schedule.stageCount++] = system;
+    schedule.stageBegin[schedule.stageCount] = SystemCount;
+
+    // A stage runs one wave after the latest earlier stage it conflicts with
+    std::array<std::size_t, SystemCount> waves{};
+    for (std::size_t stage = 0; stage < schedule.stageCount; ++stage)
+        for (std::size_t earlier = 0; earlier < stage; ++earlier)
+            for (std::size_t system = schedule.stageBegin[stage]; system < schedule.stageBegin[stage + 1]; ++system)
+                for (std::size_t other = schedule.stageBegin[earlier]; other < schedule.stageBegin[earlier + 1]; ++other)
+                    if (conflicts[system][other])
+                        waves[stage] = std::max(waves[stage], waves[earlier] + 1);
+
+    std::size_t entry = 0;
+    for (std::size_t wave = 0; entry < schedule.stageCount; ++wave)
+    {
+        schedule.waveBegin[schedule.waveCount++] = entry;
+        for (std::size_t stage = 0; stage < schedule.stageCount; ++stage)
+            if (waves[stage] == wave)
+                schedule.stageOrder[entry++] = stage;
+    }
+    schedule.waveBegin[schedule.waveCount] = entry;
+    return schedule;
+}
+
+// Fixed list of systems scheduled at compile time from their component access
+// Adjacent systems of the same single component type are fused into one pass over its pool, and the resulting stages are
+// grouped into waves whose stages touch no common component that one of them writes, every wave runs its stages concurrently
+template<class... Systems> requires (sizeof...(Systems) != 0)
+class Pipeline final
+{
+    static constexpr std::size_t SystemCount = sizeof...(Systems);
+
+    template<std::size_t I>
+    using SystemAt = std::tuple_element_t<I, std::tuple<Systems...>>;
+
+    // Row of the conflict matrix of one system against every system of the pipeline
+    template<class System>
+    static constexpr std::array<bool, SystemCount> ConflictsOf{ SystemsConflict<System, Systems>... };
+
+    static constexpr PipelineSchedule<SystemCount> Schedule = []<std::size_t... I>(std::index_sequence<I...>) noexcept
+    {
+        const std::array<bool, SystemCount> fuses{ (I != 0 && FusesWith<SystemAt<I == 0 ? 0 : I - 1>, SystemAt<I>>)... };
+        const std::array<std::array<bool, SystemCount>, SystemCount> conflicts{ ConflictsOf<SystemAt<I>>... };
+        return makePipelineSchedule<SystemCount>(fuses, conflicts);
+    }(std::make_index_sequence<SystemCount>{});
+
+public:
+    // Get the number of passes the systems are fused into
+    [[nodiscard]] static constexpr std::size_t stageCount() noexcept { return Schedule.stageCount; }
+
+    // Get the number of waves run one after another
+    [[nodiscard]] static constexpr std::size_t waveCount() noexcept { return Schedule.waveCount; }
+
+    // Run every system on a world with the same arguments, waves with a single stage run on the calling thread
+    template<class... Args> requires ((SystemConcept<Systems, Args&...> || MultiSystemConcept<Systems, Args&...> || SoASystemConcept<Systems, Args&...>) && ...)
+    static void run(World& world, Args&&... args) noexcept
+    {
+        static constexpr std::array<void (*)(World&, Args&...) noexcept, SystemCount> Stages = []<std::size_t... S>(std::index_sequence<S...>) noexcept
+        {
+            return std::array<void (*)(World&, Args&...) noexcept, SystemCount>{ &runStage<S, Args...>... };
+        }(std::make_index_sequence<SystemCount>{});
+
+        // Stages of one wave create no pools concurrently when every pool exists up front
+        (world.createPools<SystemComponentsOf<Systems>>(), ...);
+
+        ThreadPool& pool = World::threadPool();
+        for (std::size_t wave = 0; wave < Schedule.waveCount; ++wave)
+        {
+            const std::size_t begin = Schedule.waveBegin[wave];
+            const std::size_t end = Schedule.waveBegin[wave + 1];
+            if (end - begin == 1)
+            {
+                Stages[Schedule.stageOrder[begin]](world, args...);
+                continue;
+            }
+
+            ThreadPool::Counter counter{};
+            for (std::size_t entry = begin; entry < end; ++entry)
+                pool.submit([&world, &args..., stage = Schedule.stageOrder[entry]]() noexcept { Stages[stage](world, args...); }, counter);
+            pool.wait(counter);
+        }
+    }
+
+private:
+    // Run one stage, a fused stage goes through the pool once, the table of stages also holds unused entries past the stage count
+    template<std::size_t Stage, class... Args>
+    static void runStage(World& world, Args&... args) noexcept
+    {
+        if constexpr (Stage < Schedule.stageCount)
+        {
+            constexpr std::size_t Begin = Schedule.stageBegin[Stage];
+            constexpr std::size_t End = Schedule.stageBegin[Stage + 1];
+            if constexpr (End - Begin == 1)
+                world.runSystem<SystemAt<Begin>>(args...);
+            else
+                [&world, &args...]<std::size_t... I>(std::index_sequence<I...>) noexcept { world.runSystems<SystemAt<Begin + I>...>(args...); }(std::make_index_sequence<End - Begin>{});
+        }
+    }
+};
+
+// Storage grouping entities by component signature into fixed-size chunks with one column per component type
+class ArchetypeStorage final
+{
+    static constexpr std::size_t ChunkSize = 16 * 1024; // Target size of a chunk in bytes
+    static constexpr std::size_t ChunkAlignment = 64; // Alignment of a chunk and the largest supported component alignment
+    static constexpr std::size_t NoColumn = std::numeric_limits<std::size_t>::max(); // Returned for a component type not in a signature
+
+    // Entities sharing one component signature, stored row by row across chunks
+    class Archetype final
+    {
+        struct ChunkDeleter final
+        {
+            void operator()(std::byte* memory) const noexcept { ::operator delete[](memory, std::align_val_t{ ChunkAlignment }); }
+        };
+
+        using Chunk = std::unique_ptr<std::byte[], ChunkDeleter>;
+    public:
+        explicit Archetype(std::vector<ComponentInfo> columns) noexcept : m_columns{ std::move(columns) }
+        {
+            std::size_t rowBytes = sizeof(Entity::IDType);
+            std::size_t padding = 0;
+            for (const ComponentInfo& info : m_columns)
+            {
+                rowBytes += info.size;
+                padding += info.alignment;
+            }
+            m_chunkCapacity = std::max<std::size_t>(1, (ChunkSize - std::min(ChunkSize, padding)) / rowBytes);
+
+            // Columns are laid out one after another, the entity IDs first
+            std::size_t offset = sizeof(Entity::IDType) * m_chunkCapacity;
+            for (const ComponentInfo& info : m_columns)
+            {
+                offset = (offset + info.alignment - 1) / info.alignment * info.alignment;
+                m_offsets.push_back(offset);
+                offset += info.size * m_chunkCapacity;
+            }
+            m_chunkBytes = (offset + ChunkAlignment - 1) / ChunkAlignment * ChunkAlignment;
+        }
+
+        Archetype(const Archetype&) noexcept = delete;
+        Archetype(Archetype&&) noexcept = delete;
+        Archetype& operator=(const Archetype&) noexcept = delete;
+        Archetype& operator=(Archetype&&) noexcept = delete;
+
+        ~Archetype() noexcept
+        {
+            for (std::size_t row = 0; row < m_size; ++row)
+                for (std::size_t column = 0; column < m_columns.size(); ++column)
+                    m_columns[column].destroy(at(column, row));
+        }
+
+        // Get the component types of the archetype, sorted by type ID
+        [[nodiscard]] const std::vector<ComponentInfo>& columns() const noexcept { return m_columns; }
+
+        // Get the column of a component type, or NoColumn if it is not in the signature
+        [[nodiscard]] std::size_t columnIndex(ComponentTypeID id) const noexcept
+        {
+            const auto it = std::ranges::find(m_columns, id, &ComponentInfo::id);
+            return it != m_columns.end() ? static_cast<std::size_t>(it - m_columns.begin()) : NoColumn;
+        }
+
+        // Get the number of rows
+        [[nodiscard]] std::size_t size() const noexcept { return m_size; }
+
+        // Get the number of allocated chunks
+        [[nodiscard]] std::size_t chunkCount() const noexcept { return m_chunks.size(); }
+
+        // Get the number of rows in a chunk
+        [[nodiscard]] std::size_t chunkSize(std::size_t chunk) const noexcept
+        {
+            return std::min(m_chunkCapacity, m_size - chunk * m_chunkCapacity);
+        }
+
+        // Get the entity ID column of a chunk
+        [[nodiscard]] Entity::IDType* entities(std::size_t chunk) const noexcept
+        {
+            return reinterpret_cast<Entity::IDType*>(m_chunks[chunk].get());
+        }
+
+        // Get the start of a component column of a chunk
+        [[nodiscard]] void* column(std::size_t chunk, std::size_t column) const noexcept
+        {
+            return m_chunks[chunk].get() + m_offsets[column];
+        }
+
+        // Get the component of a column at a row
+        [[nodiscard]] void* at(std::size_t column, std::size_t row) const noexcept
+        {
+            return static_cast<std::byte*>(this->column(row / m_chunkCapacity, column)) + m_columns[column].size * (row % m_chunkCapacity);
+        }
+
+        // Get the entity ID at a row
+        [[nodiscard]] Entity::IDType entityAt(std::size_t row) const noexcept
+        {
+            return entities(row / m_chunkCapacity)[row % m_chunkCapacity];
+        }
+
+        // Append a row for an entity, the caller has to construct every component of the row
+        [[nodiscard]] std::size_t pushRow(Entity::IDType entityID) noexcept
+        {
+            if (m_size == m_chunks.size() * m_chunkCapacity)
+                m_chunks.emplace_back(static_cast<std::byte*>(::operator new[](m_chunkBytes, std::align_val_t{ ChunkAlignment })));
+
+            const std::size_t row = m_size++;
+            ::new (entities(row / m_chunkCapacity) + row % m_chunkCapacity) Entity::IDType{ entityID };
+            return row;
+        }
+
+        // Destroy the components of a row and move the last row into it, returns the entity now stored at the row if one was moved
+        std::optional<Entity::IDType> eraseRow(std::size_t row) noexcept
+        {
+            const std::size_t last = m_size - 1;
+            for (std::size_t column = 0; column < m_columns.size(); ++column)
+            {
+                m_columns[column].destroy(at(column, row));
+                if (row != last)
+                {
+                    m_columns[column].moveConstruct(at(column, row), at(column, last));
+                    m_columns[column].destroy(at(column, last));
+                }
+            }
+
+            std::optional<Entity::IDType> moved{};
+            if (row != last)
+            {
+                moved = entityAt(last);
+                entities(row / m_chunkCapacity)[row % m_chunkCapacity] = *moved;
+            }
+
+            if (--m_size == (m_chunks.size() - 1) * m_chunkCapacity)
+                m_chunks.pop_back();
+            return moved;
+        }
+
+        std::unordered_map<ComponentTypeID, Archetype*> addEdges{}; // Cached archetype reached by adding a component type
+        std::unordered_map<ComponentTypeID, Archetype*> removeEdges{}; // Cached archetype reached by removing a component type
+
+    private:
+        std::vector<ComponentInfo> m_columns{};
+        std::vector<std::size_t> m_offsets{}; // Byte offset of every column inside a chunk
+        std::vector<Chunk> m_chunks{};
+        std::size_t m_chunkCapacity{}; // Number of rows per chunk
+        std::size_t m_chunkBytes{};
+        std::size_t m_size{};
+    };
+
+    // Archetype and row an entity is stored at
+    struct EntityLocation final
+    {
+        Archetype* archetype;
+        std::size_t row;
+    };
+public:
+    // Add a component to an entity, moving the entity to the archetype with the extended signature
+    template<ComponentConcept Component>
+    void addComponentToEntity(Entity::IDType entityID, Component&& component) noexcept
+    {
+        const ComponentTypeID id = componentTypeID<Component>();
+        EntityLocation* location = m_locations.tryGet(entityID);
+        if (location != nullptr && location->archetype->columnIndex(id) != NoColumn)
+            return;
+
+        Archetype* source = location != nullptr ? location->archetype : nullptr;
+        Archetype*& edge = source != nullptr ? source->addEdges[id] : m_rootEdges[id];
+        if (edge == nullptr)
+        {
+            std::vector<ComponentInfo> columns = source != nullptr ? source->columns() : std::vector<ComponentInfo>{};
+            columns.insert(std::ranges::upper_bound(columns, id, {}, &ComponentInfo::id), ComponentInfo::of<Component>());
+            edge = &findOrCreate(std::move(columns));
+        }
+
+        Archetype& target = *edge;
+        const std::size_t row = moveEntity(entityID, location, target);
+        ::new (target.at(target.columnIndex(id), row)) Component(std::move(component));
+    }
+
+    // Remove a component from an entity, moving the entity to the archetype with the reduced signature
+    template<ComponentConcept Component>
+    void removeComponentFromEntity(Entity::IDType entityID) noexcept
+    {
+        const ComponentTypeID id = componentTypeID<Component>();
+        EntityLocation* location = m_locations.tryGet(entityID);
+        if (location == nullptr || location->archetype->columnIndex(id) == NoColumn)
+            return;
+
+        Archetype& source = *location->archetype;
+        if (source.columns().size() == 1)
+        {
+            destroyEntity(entityID);
+            return;
+        }
+
+        Archetype*& edge = source.removeEdges[id];
+        if (edge == nullptr)
+        {
+            std::vector<ComponentInfo> columns = source.columns();
+            std::erase_if(columns, [id](const ComponentInfo& info) noexcept { return info.id == id; });
+            edge = &findOrCreate(std::move(columns));
+        }
+        moveEntity(entityID, location, *edge);
+    }
+
+    // Check if an entity has a specific component
+    template<ComponentConcept Component>
+    [[nodiscard]] bool entityHasComponent(Entity::IDType entityID) noexcept
+    {
+        const EntityLocation* location = m_locations.tryGet(entityID);
+        return location != nullptr && location->archetype->columnIndex(componentTypeID<Component>()) != NoColumn;
+    }
+
+    // Get a pointer to a component of an entity, if it exists
+    template<ComponentConcept Component>
+    [[nodiscard]] std::optional<Component*> getComponentOfEntity(Entity::IDType entityID) noexcept
+    {
+        if (const EntityLocation* location = m_locations.tryGet(entityID); location != nullptr)
+            if (const std::size_t column = location->archetype->columnIndex(componentTypeID<Component>()); column != NoColumn)
+                return std::optional<Component*>{ static_cast<Component*>(location->archetype->at(column, location->row)) };
+        return std::optional<Component*>{ std::nullopt };
+    }
+
+    // Remove every component of an entity
+    void destroyEntity(Entity::IDType entityID) noexcept
+    {
+        if (const EntityLocation* location = m_locations.tryGet(entityID); location != nullptr)
+        {
+            eraseRow(*location);
+            m_locations.erase(entityID);
+        }
+    }
+
+    // Call a function with the entity ID and the components of every entity having all of the given types, chunk by chunk
+    template<ComponentConcept... Components, class Func> requires (sizeof...(Components) != 0) && std::is_nothrow_invocable_v<Func&, Entity::IDType, Components&...>
+    void each(Func&& func) noexcept
+    {
+        for (const auto& [signature, archetype] : m_archetypes)
+        {
+            const std::array<std::size_t, sizeof...(Components)> columns{ archetype->columnIndex(componentTypeID<Components>())... };
+            if (std::ranges::find(columns, NoColumn) != columns.end())
+                continue;
+
+            for (std::size_t chunk = 0; chunk < archetype->chunkCount(); ++chunk)
+                eachInChunk<Components...>(*archetype, chunk, columns, func, std::index_sequence_for<Components...>{});
+        }
+    }
+
+    // Apply a system to every component of its type, column by column
+    template<class System, class... Args> requires SystemConcept<System, Args&...>
+    void runSystem(Args&&... args) noexcept
+    {
+        System system{};
+        each<typename System::ComponentType>([&system, &args...](Entity::IDType, typename System::ComponentType& component) noexcept
+        {
+            system(component, args...);
+        });
+    }
+
+    // Apply a multi-component system to every entity that has all of its component types
+    template<class System, class... Args> requires MultiSystemConcept<System, Args&...>
+    void runSystem(Args&&... args) noexcept
+    {
+        runMultiSystem<System>(std::type_identity<typename System::ComponentTypes>{}, args...);
+    }
+
+private:
+    // Find the archetype with the given columns or create it
+    [[nodiscard]] Archetype& findOrCreate(std::vector<ComponentInfo> columns) noexcept
+    {
+        std::vector<ComponentTypeID> signature{};
+        for (const ComponentInfo& info : columns)
+            signature.push_back(info.id);
+
+        std::unique_ptr<Archetype>& archetype = m_archetypes[std::move(signature)];
+        if (!archetype)
+            archetype = std::make_unique<Archetype>(std::move(columns));
+        return *archetype;
+    }
+
+    // Move an entity into a new row of the target archetype, carrying over the components both signatures share
+    std::size_t moveEntity(Entity::IDType entityID, EntityLocation* location, Archetype& target) noexcept
+    {
+        const std::size_t row = target.pushRow(entityID);
+        if (location == nullptr)
+        {
+            m_locations.emplace(entityID, EntityLocation{ &target, row });
+            return row;
+        }
+
+        Archetype& source = *location->archetype;
+        for (std::size_t column = 0; column < source.columns().size(); ++column)
+            if (const std::size_t targetColumn = target.columnIndex(source.columns()[column].id); targetColumn != NoColumn)
+                source.columns()[column].moveConstruct(target.at(targetColumn, row), source.at(column, location->row));
+
+        eraseRow(*location);
+        *location = EntityLocation{ &target, row };
+        return row;
+    }
+
+    // Erase the row of an entity and fix up the location of the entity moved into it
+    void eraseRow(const EntityLocation& location) noexcept
+    {
+        if (const std::optional<Entity::IDType> moved = location.archetype->eraseRow(location.row); moved.has_value())
+            m_locations.get(*moved).row = location.row;
+    }
+
+    // Call a function for every row of one chunk with pointers into its columns
+    template<ComponentConcept... Components, class Func, std::size_t... Indices>
+    static void eachInChunk(const Archetype& archetype, std::size_t chunk, const std::array<std::size_t, sizeof...(Components)>& columns, Func& func, std::index_sequence<Indices...>) noexcept
+    {
+        const Entity::IDType* entities = archetype.entities(chunk);
+        const std::tuple<Components*...> data{ static_cast<Components*>(archetype.column(chunk, columns[Indices]))... };
+        const std::size_t size = archetype.chunkSize(chunk);
+        for (std::size_t row = 0; row < size; ++row)
+            func(entities[row], std::get<Indices>(data)[row]...);
+    }
+
+    // Unpack the component types of a multi-component system and apply it chunk by chunk
+    template<class System, class... Components, class... Args>
+    void runMultiSystem(std::type_identity<std::tuple<Components...>>, Args&... args) noexcept
+    {
+        System system{};
+        each<std::remove_const_t<Components>...>([&system, &args...](Entity::IDType, Components&... components) noexcept
+        {
+            system(components..., args...);
+        });
+    }
+
+    std::map<std::vector<ComponentTypeID>, std::unique_ptr<Archetype>> m_archetypes{}; // Archetypes by sorted signature
+    std::unordered_map<ComponentTypeID, Archetype*> m_rootEdges{}; // Archetypes of entities with a single component
+    ComponentPool<EntityLocation> m_locations{}; // Location of every entity with at least one component
+};
@@ -0,0 +1,229 @@
+#include "ECS.hpp"
+
+#include <benchmark/benchmark.h>
+
+// Memory resource counting the bytes currently allocated through it, used to report the storage cost per entity
+class CountingResource final : public std::pmr::memory_resource
+{
+public:
+    [[nodiscard]] std::size_t allocated() const noexcept { return m_allocated; }
+
+private:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override
+    {
+        m_allocated += bytes;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* pointer, std::size_t bytes, std::size_t alignment) override
+    {
+        m_allocated -= bytes;
+        std::pmr::new_delete_resource()->deallocate(pointer, bytes, alignment);
+    }
+
+    [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+    {
+        return this == &other;
+    }
+
+    std::size_t m_allocated{};
+};
+
+struct Position final
+{
+    float x{};
+    float y{};
+};
+
+struct Velocity final
+{
+    float x{};
+    float y{};
+};
+
+struct MoveSystem final
+{
+    using ComponentType = Position;
+
+    void operator()(Position& position, float dt) const noexcept
+    {
+        position.x += dt;
+        position.y += dt;
+    }
+};
+
+// World filled with entities that all have a Position and every other one a Velocity
+struct Population final
+{
+    explicit Population(std::size_t count) noexcept : world{ &memory }
+    {
+        entityIDs.reserve(count);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            entityIDs.push_back(world.createEntity().id);
+            world.addComponentToEntity(entityIDs.back(), Position{ static_cast<float>(i), 0.0f });
+            if (i % 2 == 0)
+                world.addComponentToEntity(entityIDs.back(), Velocity{ 1.0f, 1.0f });
+        }
+    }
+
+    CountingResource memory{}; // Declared first so it outlives the world
+    World world;
+    std::vector<Entity::IDType> entityIDs{};
+};
+
+// Report the time per entity and the bytes the world allocated per entity
+static void report(benchmark::State& state, std::size_t bytes) noexcept
+{
+    const double count = static_cast<double>(state.range(0));
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()) * state.range(0));
+    state.counters["time/op"] = benchmark::Counter(count, benchmark::Counter::kIsIterationInvariantRate | benchmark::Counter::kInvert);
+    state.counters["bytes/entity"] = benchmark::Counter(static_cast<double>(bytes) / count);
+}
+
+static void BM_Add(benchmark::State& state)
+{
+    const std::size_t count = static_cast<std::size_t>(state.range(0));
+    std::size_t bytes = 0;
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        {
+            CountingResource memory{};
+            World world{ &memory };
+            std::vector<Entity::IDType> entityIDs(count);
+            for (Entity::IDType& entityID : entityIDs)
+                entityID = world.createEntity().id;
+            state.ResumeTiming();
+
+            for (const Entity::IDType entityID : entityIDs)
+                world.addComponentToEntity(entityID, Position{});
+
+            state.PauseTiming();
+            bytes = memory.allocated();
+        }
+        state.ResumeTiming();
+    }
+    report(state, bytes);
+}
+
+static void BM_Remove(benchmark::State& state)
+{
+    const std::size_t count = static_cast<std::size_t>(state.range(0));
+    std::size_t bytes = 0;
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        {
+            Population population{ count };
+            bytes = population.memory.allocated();
+            state.ResumeTiming();
+
+            for (const Entity::IDType entityID : population.entityIDs)
+                population.world.removeComponentFromEntity<Position>(entityID);
+
+            state.PauseTiming();
+        }
+        state.ResumeTiming();
+    }
+    report(state, bytes);
+}
+
+static void BM_Has(benchmark::State& state)
+{
+    Population population{ static_cast<std::size_t>(state.range(0)) };
+    for (auto _ : state)
+    {
+        std::size_t found = 0;
+        for (const Entity::IDType entityID : population.entityIDs)
+            found += population.world.entityHasComponent<Velocity>(entityID);
+        benchmark::DoNotOptimize(found);
+    }
+    report(state, population.memory.allocated());
+}
+
+static void BM_Get(benchmark::State& state)
+{
+    Population population{ static_cast<std::size_t>(state.range(0)) };
+    for (auto _ : state)
+    {
+        float sum = 0.0f;
+        for (const Entity::IDType entityID : population.entityIDs)
+            sum += population.world.getComponentOfEntity<Position>(entityID).value()->x;
+        benchmark::DoNotOptimize(sum);
+    }
+    report(state, population.memory.allocated());
+}
+
+static void BM_IterateSingle(benchmark::State& state)
+{
+    Population population{ static_cast<std::size_t>(state.range(0)) };
+    for (auto _ : state)
+    {
+        for (Position& position : population.world.getComponentsSpan<Position>())
+            position.x += 1.0f;
+        benchmark::ClobberMemory();
+    }
+    report(state, population.memory.allocated());
+}
+
+static void BM_Join(benchmark::State& state)
+{
+    Population population{ static_cast<std::size_t>(state.range(0)) };
+    for (auto _ : state)
+    {
+        population.world.view<Position, Velocity>().each([](Entity::IDType, Position& position, const Velocity& velocity) noexcept
+        {
+            position.x += velocity.x;
+            position.y += velocity.y;
+        });
+        benchmark::ClobberMemory();
+    }
+    report(state, population.memory.allocated());
+}
+
+static void BM_ApplySystem(benchmark::State& state)
+{
+    Population population{ static_cast<std::size_t>(state.range(0)) };
+    for (auto _ : state)
+    {
+        for (const Entity::IDType entityID : population.entityIDs)
+            population.world.applySystem<MoveSystem>(entityID, 0.016f);
+        benchmark::ClobberMemory();
+    }
+    report(state, population.memory.allocated());
+}
+
+static void BM_BulkSpawnDespawn(benchmark::State& state)
+{
+    const std::size_t count = static_cast<std::size_t>(state.range(0));
+    CountingResource memory{};
+    World world{ &memory };
+    std::vector<Entity::IDType> entityIDs(count);
+    for (Entity::IDType& entityID : entityIDs)
+        entityID = world.createEntity().id;
+    std::vector<Velocity> velocities(count);
+
+    std::size_t bytes = 0;
+    for (auto _ : state)
+    {
+        world.addComponentsBulk<Velocity>(entityIDs, velocities, BulkPolicy::AssumeUnique);
+        bytes = memory.allocated();
+        world.removeComponentsBulk<Velocity>(entityIDs);
+    }
+    report(state, bytes);
+}
+
+// Every operation runs at 1k, 100k and 10M entities, time/op and bytes/entity are per entity
+#define ECS_BENCHMARK(function) BENCHMARK(function)->Arg(1'000)->Arg(100'000)->Arg(10'000'000)->Unit(benchmark::kMillisecond)
+
+ECS_BENCHMARK(BM_Add);
+ECS_BENCHMARK(BM_Remove);
+ECS_BENCHMARK(BM_Has);
+ECS_BENCHMARK(BM_Get);
+ECS_BENCHMARK(BM_IterateSingle);
+ECS_BENCHMARK(BM_Join);
+ECS_BENCHMARK(BM_ApplySystem);
+ECS_BENCHMARK(BM_BulkSpawnDespawn);
+
+BENCHMARK_MAIN();
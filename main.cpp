@@ -1,188 +1,179 @@
-#include <algorithm>
-#include <optional>
-#include <concepts>
-#include <cstdint>
-#include <utility>
-#include <vector>
-#include <ranges>
+#include "ECS.hpp"
 
 #include "fmt/core.h"
 
-// Represents an entity in the ECS system
-struct Entity
+// Position component representing an entity's position in 2D space
+struct Position final
 {
-    using IDType = std::uint32_t; // Entity ID type
-    IDType id{};
+    float x{};
+    float y{};
 };
 
-// Concept to ensure a type is a valid component
-template<class T>
-concept ComponentConcept = std::movable<T> && std::default_initializable<T>;
-
-// Concept to ensure a type is a valid system
-template<class System, class... Args>
-concept SystemConcept =
-    requires(System system, typename System::ComponentType& component, Args&&... args)
-    {
-        typename System::ComponentType; // System must define a ComponentType
-        { system(component, std::forward<Args>(args)...) } noexcept; // System must be callable with a component and arguments
-    } && std::default_initializable<System> && ComponentConcept<typename System::ComponentType>;
-
-// ECS (Entity-Component-System) class
-class ECS final
+// Velocity component representing an entity's velocity in 2D space
+struct Velocity final
 {
-    // Type alias for a pair of Entity ID and Component
-    template<ComponentConcept Component>
-    using EntityComponentPair = std::pair<Entity::IDType, Component>;
+    float x{};
+    float y{};
+};
 
-    // Type alias for a list of Entity-Component pairs
-    template<ComponentConcept Component>
-    using EntityComponentList = std::vector<EntityComponentPair<Component>>;
+// Particle component stored as structure of arrays, one contiguous column per member
+struct Particle final
+{
+    float x{};
+    float y{};
+    float vx{};
+    float vy{};
+};
 
-    // Helper function to match an entity ID in a list of components
-    template<ComponentConcept Component>
-    [[nodiscard]] static constexpr auto matchEntity(Entity::IDType entityID) noexcept
-    {
-        return [entityID](const EntityComponentPair<Component>& pair) noexcept -> bool
-        {
-            return pair.first == entityID;
-        };
-    }
-public:
-    // Delete default constructor and copy/move operations to enforce static usage
-    ECS() noexcept = delete;
-    ECS(const ECS&) noexcept = delete;
-    ECS(ECS&&) noexcept = delete;
-    ECS& operator=(const ECS&) noexcept = delete;
-    ECS& operator=(ECS&&) noexcept = delete;
-    ~ECS() noexcept = default;
+template<>
+struct SoALayout<Particle>
+{
+    static constexpr std::tuple members{ &Particle::x, &Particle::y, &Particle::vx, &Particle::vy };
+};
 
-    // Add a component to an entity
-    template<ComponentConcept Component>
-    static void addComponentToEntity(Entity::IDType entityID, Component&& component) noexcept
-    {
-        EntityComponentList<Component>& components = get<Component>();
-        if (std::ranges::find_if(components, matchEntity<Component>(entityID)) == components.end())
-            components.emplace_back(entityID, std::move(component));
-    }
+// MoveSystem to update an entity's position based on a time delta
+struct MoveSystem final
+{
+    using ComponentType = Position;
 
-    // Remove a component from an entity
-    template<ComponentConcept Component>
-    static void removeComponentFromEntity(Entity::IDType entityID) noexcept
+    void operator()(Position& position, float dt) const noexcept
     {
-        std::erase_if(get<Component>(), matchEntity<Component>(entityID));
+        position.x += 1.0f * dt;
+        position.y += 1.0f * dt;
     }
+};
 
-    // Check if an entity has a specific component
-    template<ComponentConcept Component>
-    [[nodiscard]] static bool entityHasComponent(Entity::IDType entityID) noexcept
-    {
-        const EntityComponentList<Component>& components = get<Component>();
-        return std::ranges::find_if(components, matchEntity<Component>(entityID)) != components.end();
-    }
+// GravitySystem to apply gravity to an entity's position
+struct GravitySystem final
+{
+    using ComponentType = Position;
 
-    // Get a pointer to a component of an entity, if it exists
-    template<ComponentConcept Component>
-    [[nodiscard]] static std::optional<Component*> getComponentOfEntity(Entity::IDType entityID) noexcept
+    void operator()(Position& position, float dt) const noexcept
     {
-        EntityComponentList<Component>& components = get<Component>();
-        if (auto it = std::ranges::find_if(components, matchEntity<Component>(entityID)); it != components.end())
-            return std::optional<Component*>{ &it->second };
-        else
-            return std::optional<Component*>{ std::nullopt };
+        position.y -= 9.81f * dt;
     }
+};
 
-    // Get a view of all components of a specific type
-    template<ComponentConcept Component>
-    [[nodiscard]] static auto getComponentsView() noexcept
-    {
-        return get<Component>() | std::views::transform([](auto& pair) -> Component* { return &pair.second; });
-    }
+// VelocitySystem to integrate an entity's velocity into its position
+struct VelocitySystem final
+{
+    using ComponentTypes = std::tuple<Position, const Velocity>;
 
-    // Get a view of all entity IDs that have a specific component
-    template<ComponentConcept Component>
-    [[nodiscard]] static auto getEntityIDsWithComponentView() noexcept
+    void operator()(Position& position, const Velocity& velocity, float dt) const noexcept
     {
-        return get<Component>() | std::views::transform([](auto& pair) -> Entity::IDType { return pair.first; });
+        position.x += velocity.x * dt;
+        position.y += velocity.y * dt;
     }
+};
 
-    // Apply a system to an entity's component
-    template<class System, class... Args> requires SystemConcept<System, Args...>
-    static void applySystem(Entity::IDType entityID, Args&&... args) noexcept
-    {
-        using Component = typename System::ComponentType;
-        EntityComponentList<Component>& components = get<Component>();
-        if (auto it = std::ranges::find_if(components, matchEntity<Component>(entityID)); it != components.end())
-            System{}(it->second, std::forward<Args>(args)...);
-    }
+// ParticleSystem to integrate particle velocities over the contiguous member columns
+struct ParticleSystem final
+{
+    using ComponentType = Particle;
 
-private:
-    // Get the static list of components for a specific type
-    template<ComponentConcept Component>
-    [[nodiscard]] static EntityComponentList<Component>& get() noexcept
+    void operator()(std::span<float> x, std::span<float> y, std::span<float> vx, std::span<float> vy, float dt) const noexcept
     {
-        static EntityComponentList<Component> instance{};
-        return instance;
+        std::size_t i = 0;
+#if defined(__AVX2__)
+        const __m256 step = _mm256_set1_ps(dt);
+        for (; i + 8 <= x.size(); i += 8)
+        {
+            _mm256_storeu_ps(&x[i], _mm256_add_ps(_mm256_loadu_ps(&x[i]), _mm256_mul_ps(_mm256_loadu_ps(&vx[i]), step)));
+            _mm256_storeu_ps(&y[i], _mm256_add_ps(_mm256_loadu_ps(&y[i]), _mm256_mul_ps(_mm256_loadu_ps(&vy[i]), step)));
+        }
+#endif
+        for (; i < x.size(); ++i)
+        {
+            x[i] += vx[i] * dt;
+            y[i] += vy[i] * dt;
+        }
     }
 };
 
-// Position component representing an entity's position in 2D space
-struct Position final
+// Inventory component whose gold is loaded from a database
+struct Inventory final
 {
-    float x{};
-    float y{};
+    std::uint32_t ownerID{};
+    int gold{};
 };
 
-// MoveSystem to update an entity's position based on a time delta
-struct MoveSystem final
+// Stand-in for a database answering every lookup on its own thread after a delay
+class Database final
 {
-    using ComponentType = Position;
+public:
+    Database() noexcept = default;
+    Database(const Database&) noexcept = delete;
+    Database& operator=(const Database&) noexcept = delete;
 
-    void operator()(Position& position, float dt) const noexcept
+    ~Database() noexcept
     {
-        position.x += 1.0f * dt;
-        position.y += 1.0f * dt;
+        for (std::thread& request : m_requests)
+            request.join();
     }
+
+    // Look up the gold of an owner, the result is completed from the thread of the request
+    void lookupGold(std::uint32_t ownerID, std::shared_ptr<AsyncValue<int>> gold) noexcept
+    {
+        std::lock_guard lock{ m_mutex };
+        m_requests.emplace_back([ownerID, gold = std::move(gold)]() noexcept
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds{ 10 });
+            gold->complete(static_cast<int>(ownerID) * 10);
+        });
+    }
+
+private:
+    std::mutex m_mutex{};
+    std::vector<std::thread> m_requests{};
 };
 
-// GravitySystem to apply gravity to an entity's position
-struct GravitySystem final
+// InventoryLoadSystem to fill inventories from the database, suspended without holding a thread while the lookup runs
+struct InventoryLoadSystem final
 {
-    using ComponentType = Position;
+    using ComponentType = Inventory;
 
-    void operator()(Position& position, float dt) const noexcept
+    AsyncTask operator()(Entity::IDType entityID, Inventory inventory, AsyncContext& context, Database* database) const noexcept
     {
-        position.y -= 9.81f * dt;
+        const std::shared_ptr<AsyncValue<int>> gold = std::make_shared<AsyncValue<int>>();
+        database->lookupGold(inventory.ownerID, gold);
+        inventory.gold = co_await *gold;
+        context.commands().setComponent(entityID, std::move(inventory));
     }
 };
 
 int main([[maybe_unused]] int, [[maybe_unused]] char**)
 {
+    World world{};
+
+    // The examples below address entities by fixed IDs, create them up front so they are alive in the world
+    for (int i = 0; i <= 10; ++i)
+        static_cast<void>(world.createEntity());
+
     // Example usage of the ECS system
     {
         Entity entity{1};
 
         // Add, remove, and re-add a Position component to an entity
-        ECS::addComponentToEntity(entity.id, Position{ 0.0f, 0.0f });
-        ECS::removeComponentFromEntity<Position>(entity.id);
-        ECS::addComponentToEntity(entity.id, Position{ 2.0f, 3.0f });
+        world.addComponentToEntity(entity.id, Position{ 0.0f, 0.0f });
+        world.removeComponentFromEntity<Position>(entity.id);
+        world.addComponentToEntity(entity.id, Position{ 2.0f, 3.0f });
 
         // Apply the MoveSystem to the entity
-        ECS::applySystem<MoveSystem>(entity.id, 0.016f);
+        world.applySystem<MoveSystem>(entity.id, 0.016f);
 
         // Print all entities with a Position component
-        const auto entities = ECS::getEntityIDsWithComponentView<Position>();
+        const auto entities = world.getEntityIDsWithComponentView<Position>();
         fmt::print("Entities with Position component: {}\n", entities.size());
         for (const Entity::IDType entityID : entities)
             fmt::print("Entity ID: {}\n", entityID);
 
         // Print all Position components
-        const auto positions = ECS::getComponentsView<Position>();
+        const auto positions = world.getComponentsView<Position>();
         for (const Position* position : positions)
             fmt::print("Position: ({}, {})\n", position->x, position->y);
 
         // Remove the Position component from the entity
-        ECS::removeComponentFromEntity<Position>(entity.id);
+        world.removeComponentFromEntity<Position>(entity.id);
     }
 
     // Additional examples with multiple entities
@@ -193,67 +184,620 @@ int main([[maybe_unused]] int, [[maybe_unused]] char**)
         Entity entity5{5};
 
         // Add Position components to multiple entities
-        ECS::addComponentToEntity(entity2.id, Position{ 5.0f, 5.0f });
-        ECS::addComponentToEntity(entity3.id, Position{ 10.0f, 10.0f });
-        ECS::addComponentToEntity(entity4.id, Position{ 15.0f, 15.0f });
-        ECS::addComponentToEntity(entity5.id, Position{ 20.0f, 20.0f });
+        world.addComponentToEntity(entity2.id, Position{ 5.0f, 5.0f });
+        world.addComponentToEntity(entity3.id, Position{ 10.0f, 10.0f });
+        world.addComponentToEntity(entity4.id, Position{ 15.0f, 15.0f });
+        world.addComponentToEntity(entity5.id, Position{ 20.0f, 20.0f });
 
         // Print entities with Position components
         {
-            const auto entities = ECS::getEntityIDsWithComponentView<Position>();
+            const auto entities = world.getEntityIDsWithComponentView<Position>();
             fmt::print("Entities with Position component: {}\n", entities.size());
         }
 
         // Apply the MoveSystem to the first two entities
-        for (Entity::IDType entityID : ECS::getEntityIDsWithComponentView<Position>() | std::views::take(2))
+        for (Entity::IDType entityID : world.getEntityIDsWithComponentView<Position>() | std::views::take(2))
         {
-            ECS::applySystem<MoveSystem>(entityID, 0.016f);
+            world.applySystem<MoveSystem>(entityID, 0.016f);
             fmt::print("Entity ID after move: {}\n", entityID);
-            if (const std::optional<Position*> pos = ECS::getComponentOfEntity<Position>(entityID); pos.has_value())
+            if (const std::optional<Position*> pos = world.getComponentOfEntity<Position>(entityID); pos.has_value())
                 fmt::print("Position after move: ({}, {})\n", (*pos)->x, (*pos)->y);
         }
 
         // Print all entities and their Position components
         {
-            const auto entities = ECS::getEntityIDsWithComponentView<Position>();
+            const auto entities = world.getEntityIDsWithComponentView<Position>();
             fmt::print("Entities with Position component: {}\n", entities.size());
             
             for (Entity::IDType entityID : entities)
                 fmt::print("Entity ID: {}\n", entityID);
 
-            const auto positions = ECS::getComponentsView<Position>();
+            const auto positions = world.getComponentsView<Position>();
             for (const Position* position : positions)
                 fmt::print("Position: ({}, {})\n", position->x, position->y);
         }
 
         // Remove Position components from all entities
-        ECS::removeComponentFromEntity<Position>(entity2.id);
-        ECS::removeComponentFromEntity<Position>(entity3.id);
-        ECS::removeComponentFromEntity<Position>(entity4.id);
-        ECS::removeComponentFromEntity<Position>(entity5.id);
+        world.removeComponentFromEntity<Position>(entity2.id);
+        world.removeComponentFromEntity<Position>(entity3.id);
+        world.removeComponentFromEntity<Position>(entity4.id);
+        world.removeComponentFromEntity<Position>(entity5.id);
+    }
+
+    // Example with an order preserving removal
+    {
+        std::vector<Entity::IDType> entityIDs{};
+        for (int i = 0; i < 4; ++i)
+        {
+            entityIDs.push_back(world.createEntity().id);
+            world.addComponentToEntity(entityIDs.back(), Position{ static_cast<float>(i), 0.0f });
+        }
+
+        // Remove the first entity, keeping the iteration order of the remaining ones instead of moving the last one into its slot
+        world.removeComponentFromEntity<Position>(entityIDs[0], RemovalOrder::Stable);
+        for (Entity::IDType entityID : world.getEntityIDsWithComponentView<Position>())
+            fmt::print("Entity ID after stable removal: {}\n", entityID);
+
+        for (Entity::IDType entityID : entityIDs)
+            world.destroyEntity(entityID);
+    }
+
+    // Example with a system applied to a whole pool
+    {
+        std::vector<Entity::IDType> entityIDs{};
+        for (int i = 0; i < 3; ++i)
+        {
+            entityIDs.push_back(world.createEntity().id);
+            world.addComponentToEntity(entityIDs.back(), Position{ 0.0f, 10.0f * static_cast<float>(i) });
+        }
+
+        // Apply the GravitySystem to all entities in a single pass
+        world.runSystem<GravitySystem>(0.016f);
+        for (const Position* position : world.getComponentsView<Position>())
+            fmt::print("Position after gravity pass: ({}, {})\n", position->x, position->y);
+
+        for (Entity::IDType entityID : entityIDs)
+            world.destroyEntity(entityID);
     }
 
     // Example with GravitySystem
     {
         Entity entity6{6};
         
-        ECS::addComponentToEntity(entity6.id, Position{ 50.0f, 50.0f });
+        world.addComponentToEntity(entity6.id, Position{ 50.0f, 50.0f });
 
         // Apply the GravitySystem to the entity
-        ECS::applySystem<GravitySystem>(entity6.id, 0.016f);
-        if (const std::optional<Position*> pos = ECS::getComponentOfEntity<Position>(entity6.id); pos.has_value())
+        world.applySystem<GravitySystem>(entity6.id, 0.016f);
+        if (const std::optional<Position*> pos = world.getComponentOfEntity<Position>(entity6.id); pos.has_value())
             fmt::print("Entity ID after gravity: {}\nPosition after gravity: ({}, {})\n", entity6.id, (*pos)->x, (*pos)->y);
 
-        ECS::removeComponentFromEntity<Position>(entity6.id);
+        world.removeComponentFromEntity<Position>(entity6.id);
     }
 
     // Check if an entity has a component
     {
         Entity entity7{7};
-        ECS::addComponentToEntity(entity7.id, Position{ 25.0f, 25.0f });
-        fmt::print("Entity7 has Position component: {}\n", ECS::entityHasComponent<Position>(entity7.id));
-        ECS::removeComponentFromEntity<Position>(entity7.id);
-        fmt::print("Entity7 has Position component after removal: {}\n", ECS::entityHasComponent<Position>(entity7.id));
+        world.addComponentToEntity(entity7.id, Position{ 25.0f, 25.0f });
+        fmt::print("Entity7 has Position component: {}\n", world.entityHasComponent<Position>(entity7.id));
+        world.removeComponentFromEntity<Position>(entity7.id);
+        fmt::print("Entity7 has Position component after removal: {}\n", world.entityHasComponent<Position>(entity7.id));
+    }
+
+    // Example with a multi-component view and system
+    {
+        Entity entity8{8};
+        Entity entity9{9};
+        Entity entity10{10};
+
+        world.addComponentToEntity(entity8.id, Position{ 0.0f, 0.0f });
+        world.addComponentToEntity(entity8.id, Velocity{ 1.0f, 2.0f });
+        world.addComponentToEntity(entity9.id, Position{ 5.0f, 5.0f });
+        world.addComponentToEntity(entity10.id, Position{ 10.0f, 10.0f });
+        world.addComponentToEntity(entity10.id, Velocity{ -1.0f, 0.0f });
+
+        // Apply the VelocitySystem to every entity with both a Position and a Velocity
+        world.runSystem<VelocitySystem>(1.0f);
+
+        for (const auto [entityID, position, velocity] : world.view<Position, Velocity>())
+            fmt::print("Entity ID: {} Position: ({}, {}) Velocity: ({}, {})\n", entityID, position.x, position.y, velocity.x, velocity.y);
+
+        // Run the systems on the thread pool, VelocitySystem and MoveSystem both write Position so they run one after another
+        world.runSystemParallel<VelocitySystem>(1.0f);
+        Scheduler scheduler{};
+        scheduler.add<VelocitySystem>(1.0f).add<MoveSystem>(1.0f);
+        scheduler.run(world);
+
+        if (const std::optional<Position*> pos = world.getComponentOfEntity<Position>(entity10.id); pos.has_value())
+            fmt::print("Entity ID: {} Position after scheduled systems: ({}, {})\n", entity10.id, (*pos)->x, (*pos)->y);
+
+        world.removeComponentFromEntity<Position>(entity8.id);
+        world.removeComponentFromEntity<Velocity>(entity8.id);
+        world.removeComponentFromEntity<Position>(entity9.id);
+        world.removeComponentFromEntity<Position>(entity10.id);
+        world.removeComponentFromEntity<Velocity>(entity10.id);
+    }
+
+    // Example with a structure-of-arrays component
+    {
+        std::vector<Entity::IDType> entityIDs{};
+        for (int i = 0; i < 10; ++i)
+        {
+            entityIDs.push_back(world.createEntity().id);
+            world.addComponentToEntity(entityIDs.back(), Particle{ 0.0f, 0.0f, static_cast<float>(20 + i), 1.0f });
+        }
+        world.removeComponentFromEntity<Particle>(entityIDs[5]);
+
+        world.runSystem<ParticleSystem>(0.5f);
+        world.runSystemParallel<ParticleSystem>(0.5f);
+
+        const auto [x, y, vx, vy] = world.getComponentColumns<Particle>();
+        fmt::print("Particles: {} First particle position: ({}, {})\n", x.size(), x.front(), y.front());
+    }
+
+    // Example with several isolated worlds, the shard allocates its pools from a monotonic arena released all at once
+    {
+        std::pmr::monotonic_buffer_resource shardArena{ 64 * 1024 };
+        World shard{ &shardArena };
+        shard.reserve<Position>(1024);
+        const Entity entity = shard.createEntity();
+        shard.addComponentToEntity(entity.id, Position{ 1.0f, 1.0f });
+        fmt::print("Shard has the entity: {} World is unaffected: {}\n", shard.entityHasComponent<Position>(entity.id), !world.entityHasComponent<Position>(entity.id));
+        shard.destroyEntity(entity.id);
+    }
+
+    // Example with generational entity IDs
+    {
+        const Entity first = world.createEntity();
+        world.addComponentToEntity(first.id, Velocity{ 1.0f, 1.0f });
+        world.destroyEntity(first.id);
+
+        // The recycled index comes back with a new generation, the stale ID no longer matches
+        const Entity second = world.createEntity();
+        world.addComponentToEntity(second.id, Velocity{ 2.0f, 2.0f });
+        fmt::print("Recycled index: {} Generation: {} Stale ID alive: {} Stale ID has Velocity: {}\n", Entity::indexOf(second.id),
+            Entity::generationOf(second.id), world.isAlive(first.id), world.entityHasComponent<Velocity>(first.id));
+        world.destroyEntity(second.id);
+    }
+
+    // Example with bulk spawning and despawning
+    {
+        std::vector<Entity::IDType> wave(1000);
+        std::vector<Velocity> velocities(wave.size(), Velocity{ 0.0f, -1.0f });
+        for (Entity::IDType& entityID : wave)
+            entityID = world.createEntity().id;
+
+        world.addComponentsBulk<Velocity>(wave, velocities, BulkPolicy::AssumeUnique);
+        fmt::print("Entities with Velocity component after spawn: {}\n", world.getEntityIDsWithComponentView<Velocity>().size());
+
+        // Despawn every other entity of the wave while keeping the iteration order of the rest
+        std::vector<Entity::IDType> despawned{};
+        for (std::size_t i = 0; i < wave.size(); i += 2)
+            despawned.push_back(wave[i]);
+        world.removeComponentsBulk<Velocity>(despawned, RemovalOrder::Stable);
+        fmt::print("Entities with Velocity component after despawn: {} First: {}\n", world.getEntityIDsWithComponentView<Velocity>().size(),
+            world.getEntityIDsWithComponentView<Velocity>().front());
+
+        for (const Entity::IDType entityID : wave)
+            world.destroyEntity(entityID);
+    }
+
+    // Example with deferred structural changes recorded while iterating
+    {
+        for (int i = 0; i < 8; ++i)
+        {
+            const Entity entity = world.createEntity();
+            world.addComponentToEntity(entity.id, Position{ static_cast<float>(i), static_cast<float>(i) });
+        }
+
+        // Structural changes during iteration are recorded and replayed after it, so the view is never invalidated
+        for (const auto [entityID, position] : world.view<Position>())
+        {
+            if (position.x < 4.0f)
+                world.commands().destroyEntity(entityID);
+            else
+                world.commands().addComponent(entityID, Velocity{ 1.0f, 0.0f });
+        }
+        world.flushCommands();
+        fmt::print("Entities with Position component after flush: {} with Velocity component: {}\n",
+            world.getEntityIDsWithComponentView<Position>().size(), world.getEntityIDsWithComponentView<Velocity>().size());
+
+        for (const Entity::IDType entityID : world.getEntityIDsWithComponentView<Position>())
+            world.commands().destroyEntity(entityID);
+        world.flushCommands();
+    }
+
+    // Example with change detection
+    {
+        world.enableChangeTracking<Position>();
+        const Tick baseline = world.currentTick();
+        world.advanceTick();
+
+        const Entity moved = world.createEntity();
+        const Entity resting = world.createEntity();
+        world.addComponentToEntity(moved.id, Position{ 0.0f, 0.0f });
+        world.addComponentToEntity(resting.id, Position{ 0.0f, 0.0f });
+
+        const Tick synced = world.currentTick();
+        world.advanceTick();
+        world.applySystem<MoveSystem>(moved.id, 1.0f);
+
+        fmt::print("Positions changed since baseline: {} since last sync: {}\n", std::ranges::distance(world.changed<Position>(baseline)),
+            std::ranges::distance(world.changed<Position>(synced)));
+        for (const auto [entityID, position] : world.changed<Position>(synced))
+            fmt::print("Changed entity ID: {} Position: ({}, {})\n", entityID, position->x, position->y);
+
+        world.destroyEntity(moved.id);
+        world.destroyEntity(resting.id);
+    }
+
+    // Example with seqlock reads, a network thread reads positions while the simulation keeps writing them
+    {
+        const SeqLockPool<Position>& positions = world.enableSeqLockReads<Position>();
+        const Entity entity = world.createEntity();
+        world.addComponentToEntity(entity.id, Position{ 0.0f, 0.0f });
+        world.advanceTick();
+
+        // Every read sees one whole published tick, so x and y always match and never go back
+        std::atomic<bool> running{ true };
+        bool consistent = true;
+        std::thread network{ [&positions, &running, &consistent, entityID = entity.id]()
+        {
+            float lastX = 0.0f;
+            while (running.load(std::memory_order_relaxed))
+                if (const std::optional<Position> position = positions.read(entityID); position)
+                {
+                    consistent = consistent && position->x == position->y && position->x >= lastX;
+                    lastX = position->x;
+                }
+        } };
+
+        for (int i = 0; i < 100; ++i)
+        {
+            world.applySystem<MoveSystem>(entity.id, 1.0f);
+            world.advanceTick();
+        }
+        running.store(false, std::memory_order_relaxed);
+        network.join();
+        fmt::print("Network thread reads consistent: {} last published x: {}\n", consistent, positions.read(entity.id).value().x);
+
+        world.disableSharedReads<Position>();
+        world.destroyEntity(entity.id);
+    }
+
+    // Example with double and triple buffering, the previous tick stays readable for interpolation while the next one is written
+    {
+        world.enableDoubleBuffering<Position>();
+        const Entity entity = world.createEntity();
+        world.addComponentToEntity(entity.id, Position{ 0.0f, 0.0f });
+        world.advanceTick();
+        world.applySystem<MoveSystem>(entity.id, 1.0f);
+
+        const float alpha = 0.25f;
+        const float previousX = world.getPreviousComponentsView<Position>().value()->tryGet(entity.id)->x;
+        const float currentX = world.readComponentOfEntity<Position>(entity.id).value()->x;
+        fmt::print("Interpolated x: {}\n", previousX + (currentX - previousX) * alpha);
+
+        // A render thread takes the latest finished tick whenever it is ready, without locking or waiting for the simulation
+        TripleBufferedPool<Position>& frames = world.enableTripleBuffering<Position>();
+        std::atomic<bool> running{ true };
+        bool consistent = true;
+        std::thread render{ [&frames, &running, &consistent, entityID = entity.id]()
+        {
+            while (running.load(std::memory_order_relaxed))
+                if (const Position* position = frames.latest().tryGet(entityID); position != nullptr)
+                    consistent = consistent && position->x == position->y;
+        } };
+        for (int i = 0; i < 10; ++i)
+        {
+            world.applySystem<MoveSystem>(entity.id, 1.0f);
+            world.advanceTick();
+        }
+        running.store(false, std::memory_order_relaxed);
+        render.join();
+        fmt::print("Render frames consistent: {} latest frame tick: {} of {}\n", consistent, frames.latest().tick(), world.currentTick() - 1);
+
+        world.disableSharedReads<Position>();
+        world.destroyEntity(entity.id);
+    }
+
+    // Example with an async system, the frame loop keeps running while the inventories load
+    {
+        Database database{};
+        std::vector<Entity::IDType> entityIDs{};
+        for (std::uint32_t ownerID = 1; ownerID <= 4; ++ownerID)
+        {
+            entityIDs.push_back(world.createEntity().id);
+            world.addComponentToEntity(entityIDs.back(), Inventory{ ownerID, 0 });
+        }
+
+        world.runAsyncSystem<InventoryLoadSystem>(&database);
+        std::size_t frames = 0;
+        while (world.asyncSystemsInFlight() != 0)
+        {
+            world.flushCommands();
+            world.advanceTick();
+            ++frames;
+            std::this_thread::sleep_for(std::chrono::milliseconds{ 1 });
+        }
+        world.waitForAsyncSystems();
+
+        int gold = 0;
+        for (const Inventory& inventory : world.getComponentsSpan<Inventory>())
+            gold += inventory.gold;
+        fmt::print("Loaded gold: {} frame loop kept running: {}\n", gold, frames != 0);
+
+        for (const Entity::IDType entityID : entityIDs)
+            world.destroyEntity(entityID);
+    }
+
+    // Example with a spatial grid, neighbour queries only look at the cells around the point
+    {
+        SpatialGrid<Position> grid = world.spatialGrid<Position>(4.0f);
+        std::vector<Entity::IDType> entityIDs{};
+        for (int i = 0; i < 100; ++i)
+        {
+            entityIDs.push_back(world.createEntity().id);
+            world.addComponentToEntity(entityIDs.back(), Position{ static_cast<float>(i % 10) * 2.0f, static_cast<float>(i / 10) * 2.0f });
+        }
+
+        world.applySystem<MoveSystem>(entityIDs.front(), 1.0f);
+        grid.update();
+        fmt::print("Entities within 2.5 of (10, 10): {} nearest to (1, 1) is the moved entity: {}\n", grid.queryRadius(10.0f, 10.0f, 2.5f).size(),
+            grid.nearest(1.0f, 1.0f, 1).front() == entityIDs.front());
+
+        for (const Entity::IDType entityID : entityIDs)
+            world.destroyEntity(entityID);
+    }
+
+    // Example with memory stats, the pool keeps its capacity after a despawn wave until it is shrunk a slice per tick
+    {
+        std::vector<Entity::IDType> entityIDs{};
+        for (int i = 0; i < 10000; ++i)
+        {
+            entityIDs.push_back(world.createEntity().id);
+            world.addComponentToEntity(entityIDs.back(), Velocity{ 1.0f, 0.0f });
+        }
+        for (const Entity::IDType entityID : entityIDs)
+            world.destroyEntity(entityID);
+
+        const PoolStats before = world.poolStats<Velocity>();
+        std::size_t ticks = 1;
+        while (!world.shrinkToFit(16 * 1024))
+        {
+            world.advanceTick();
+            ++ticks;
+        }
+        const PoolStats after = world.poolStats<Velocity>();
+        fmt::print("Velocity pool bytes: {} before shrinking, {} after {} ticks, fragmentation {:.2f} before\n", before.bytes, after.bytes, ticks, before.fragmentation);
+    }
+
+    // Example with a component registered at runtime, as a script would, walked in bulk through its raw block
+    {
+        const ComponentInfo health = ComponentInfo::runtime(sizeof(float), alignof(float),
+            [](void* destination, void* source) noexcept { ::new (destination) float{ *static_cast<float*>(source) }; },
+            [](void*) noexcept {}).value();
+        world.registerComponent(health);
+
+        std::vector<Entity::IDType> entityIDs{};
+        for (int i = 0; i < 4; ++i)
+        {
+            entityIDs.push_back(world.createEntity().id);
+            float value = 100.0f;
+            world.addComponentToEntity(entityIDs.back(), health.id, &value);
+            world.addComponentToEntity(entityIDs.back(), Position{ static_cast<float>(i), 0.0f });
+        }
+        world.removeComponentFromEntity(entityIDs.front(), health.id);
+
+        const ComponentBlock block = world.getComponentBlock(health.id);
+        for (std::size_t i = 0; i < block.entities.size(); ++i)
+            *reinterpret_cast<float*>(block.data + i * block.stride) -= 25.0f;
+
+        float sumX = 0.0f;
+        const ComponentBlock positions = world.getComponentBlock(componentTypeID<Position>());
+        for (std::size_t i = 0; i < positions.entities.size(); ++i)
+            sumX += reinterpret_cast<const Position*>(positions.data + i * positions.stride)->x;
+
+        fmt::print("Runtime health of the last entity: {} entities with it: {} first entity has it: {} raw Position x sum: {}\n",
+            *static_cast<float*>(world.getComponentOfEntity(entityIDs.back(), health.id).value()), block.entities.size(),
+            world.entityHasComponent(entityIDs.front(), health.id), sumX);
+
+        for (const Entity::IDType entityID : entityIDs)
+            world.destroyEntity(entityID);
+    }
+
+    // Example with add and remove observers
+    {
+        const ObserverID added = world.onAdd<Velocity>([](Entity::IDType entityID) { fmt::print("Velocity added to entity index: {}\n", Entity::indexOf(entityID)); });
+        const ObserverID removed = world.onRemoveBatch<Velocity>([](std::span<const Entity::IDType> entityIDs) { fmt::print("Velocity removed from {} entities\n", entityIDs.size()); });
+
+        const Entity first = world.createEntity();
+        const Entity second = world.createEntity();
+        world.addComponentToEntity(first.id, Velocity{ 1.0f, 0.0f });
+        world.addComponentToEntity(second.id, Velocity{ 0.0f, 1.0f });
+
+        // The batch observer is called once with both entities at the end of the flush
+        world.commands().destroyEntity(first.id);
+        world.commands().destroyEntity(second.id);
+        world.flushCommands();
+
+        world.disconnect<Velocity>(added);
+        world.disconnect<Velocity>(removed);
+    }
+
+    // Example with a cached query, frozen entities drop out of the matches without rescanning the pools
+    {
+        struct Frozen final {};
+        Query<Position, Velocity, Exclude<Frozen>> moving = world.query<Position, Velocity, Exclude<Frozen>>();
+
+        const Entity entity = world.createEntity();
+        world.addComponentToEntity(entity.id, Position{ 0.0f, 0.0f });
+        world.addComponentToEntity(entity.id, Velocity{ 1.0f, 1.0f });
+        const std::size_t matches = moving.size();
+        world.addComponentToEntity(entity.id, Frozen{});
+        fmt::print("Query matches: {} before freezing, {} after\n", matches, moving.size());
+
+        moving.each([](Entity::IDType, Position& position, Velocity& velocity) noexcept
+        {
+            position.x += velocity.x;
+            position.y += velocity.y;
+        });
+        world.destroyEntity(entity.id);
+    }
+
+    // Example with a group, the entities with both components line up at the front of both pools
+    {
+        Group<Position, Velocity> moving = world.group<Position, Velocity>();
+
+        std::vector<Entity::IDType> entityIDs{};
+        for (int i = 0; i < 4; ++i)
+        {
+            entityIDs.push_back(world.createEntity().id);
+            world.addComponentToEntity(entityIDs.back(), Position{ static_cast<float>(i), 0.0f });
+            if (i % 2 == 0)
+                world.addComponentToEntity(entityIDs.back(), Velocity{ 1.0f, 0.0f });
+        }
+
+        moving.each([](Entity::IDType, Position& position, Velocity& velocity) noexcept { position.x += velocity.x; });
+        fmt::print("Group size: {}\n", moving.size());
+
+        for (Entity::IDType entityID : entityIDs)
+            world.destroyEntity(entityID);
+    }
+
+    // Example with a binary snapshot, the restored world keeps the same entity IDs
+    {
+        World saved{};
+        const Entity entity = saved.createEntity();
+        saved.addComponentToEntity(entity.id, Position{ 3.0f, 4.0f });
+        saved.addComponentToEntity(entity.id, Velocity{ 1.0f, 2.0f });
+
+        World restored{};
+        if (saved.saveSnapshot<Position, Velocity>("snapshot.bin") && restored.loadSnapshot<Position, Velocity>("snapshot.bin"))
+            fmt::print("Restored position: {} {}\n", restored.getComponentOfEntity<Position>(entity.id).value()->x, restored.getComponentOfEntity<Position>(entity.id).value()->y);
+        std::remove("snapshot.bin");
+    }
+
+    // Example with delta replication, the second packet only carries the one moved position
+    {
+        World server{};
+        World client{};
+        DeltaEncoder<Position, Velocity> encoder{ server };
+        DeltaDecoder<Position, Velocity> decoder{ client };
+        std::vector<std::uint8_t> packet{};
+
+        std::vector<Entity::IDType> entityIDs{};
+        for (int i = 0; i < 100; ++i)
+        {
+            entityIDs.push_back(server.createEntity().id);
+            server.addComponentToEntity(entityIDs.back(), Position{ static_cast<float>(i), 0.0f });
+        }
+        encoder.encode(packet);
+        decoder.decode(packet);
+        server.advanceTick();
+        const std::size_t fullSize = packet.size();
+
+        server.applySystem<MoveSystem>(entityIDs.front(), 1.0f);
+        encoder.encode(packet);
+        decoder.decode(packet);
+        server.advanceTick();
+        fmt::print("Delta packet sizes: {} bytes then {} bytes, client position: {}\n", fullSize, packet.size(), client.readComponentOfEntity<Position>(entityIDs.front()).value()->x);
+    }
+
+    // Example with a compile-time pipeline, Move and Gravity share one pass over the positions and Velocity runs after them
+    {
+        using FramePipeline = Pipeline<MoveSystem, GravitySystem, VelocitySystem>;
+        static_assert(FramePipeline::stageCount() == 2 && FramePipeline::waveCount() == 2);
+        FramePipeline::run(world, 0.016f);
+        fmt::print("Pipeline stages: {} waves: {}\n", FramePipeline::stageCount(), FramePipeline::waveCount());
+    }
+
+    // Example with a hierarchy, one sweep in pool order sees every parent before its children
+    {
+        const Entity root = world.createEntity();
+        const Entity arm = world.createEntity();
+        const Entity hand = world.createEntity();
+        world.setParent(hand.id, arm.id);
+        world.setParent(arm.id, root.id);
+        world.addComponentToEntity(root.id, Position{ 1.0f, 0.0f });
+        world.addComponentToEntity(arm.id, Position{ 0.0f, 2.0f });
+        world.addComponentToEntity(hand.id, Position{ 0.5f, 0.0f });
+
+        // Accumulate the local positions into world positions from the roots down, sorting the positions in hierarchy order first
+        // makes the sweep walk both pools in step
+        world.sortAs<Relationship, Position>();
+        const HierarchyPool& hierarchy = world.hierarchy();
+        for (std::size_t slot = 0; slot < hierarchy.size(); ++slot)
+        {
+            const Relationship& relationship = hierarchy.relationships()[slot];
+            if (relationship.parent == Relationship::None)
+                continue;
+
+            Position* position = world.getComponentOfEntity<Position>(hierarchy.entities()[slot]).value();
+            const Position* parent = world.readComponentOfEntity<Position>(relationship.parent).value();
+            position->x += parent->x;
+            position->y += parent->y;
+        }
+        fmt::print("Hand world position: {} {}\n", world.readComponentOfEntity<Position>(hand.id).value()->x, world.readComponentOfEntity<Position>(hand.id).value()->y);
+    }
+
+    // Example with a sorted pool, positions are ordered along a Morton curve over 16 unit cells so neighbors sit close in memory
+    {
+        const auto morton = [](const Position& position) noexcept
+        {
+            std::uint32_t code = 0;
+            const std::uint32_t x = static_cast<std::uint32_t>(static_cast<std::int32_t>(position.x / 16.0f)) & 0xffff;
+            const std::uint32_t y = static_cast<std::uint32_t>(static_cast<std::int32_t>(position.y / 16.0f)) & 0xffff;
+            for (unsigned bit = 0; bit < 16; ++bit)
+                code |= ((x >> bit) & 1u) << (2 * bit) | ((y >> bit) & 1u) << (2 * bit + 1);
+            return code;
+        };
+        world.sort<Position>([&morton](const Position& first, const Position& second) noexcept { return morton(first) < morton(second); });
+        fmt::print("Positions sorted by Morton code: {}\n", std::ranges::is_sorted(world.getComponentsSpan<Position>(), {}, morton));
+    }
+
+    // Example with a tag component, the pool of an empty type stores only entity IDs
+    {
+        struct Enemy final {};
+        for (int i = 0; i < 3; ++i)
+        {
+            const Entity entity = world.createEntity();
+            world.addComponentToEntity(entity.id, Position{ static_cast<float>(i), 0.0f });
+            if (i != 1)
+                world.addComponentToEntity(entity.id, Enemy{});
+        }
+
+        std::size_t enemies = 0;
+        world.view<Position, Enemy>().each([&enemies](Entity::IDType, Position&, Enemy&) noexcept { ++enemies; });
+        fmt::print("Enemies with a position: {}\n", enemies);
+    }
+
+#if ECS_PROFILING
+    // Example with the profiler, prints the totals of the last tick and exports a trace of every run
+    {
+        world.runSystem<GravitySystem>(0.016f);
+        world.runSystemParallel<MoveSystem>(0.016f);
+        world.advanceTick();
+        for (const Profiler::SystemTotals& totals : world.profiler().lastTickTotals())
+            fmt::print("{}: {} runs {} entities {} ns\n", totals.name, totals.runs, totals.entities, totals.duration);
+        world.profiler().writeChromeTrace("trace.json");
+    }
+#endif
+
+    // Example with the archetype storage
+    {
+        ArchetypeStorage storage{};
+        for (Entity::IDType entityID = 11; entityID < 15; ++entityID)
+            storage.addComponentToEntity(entityID, Position{ static_cast<float>(entityID), 0.0f });
+        storage.addComponentToEntity(12u, Velocity{ 0.0f, 1.0f });
+        storage.addComponentToEntity(14u, Velocity{ 0.0f, 2.0f });
+        storage.removeComponentFromEntity<Position>(11u);
+
+        storage.runSystem<VelocitySystem>(1.0f);
+        storage.each<Position>([](Entity::IDType entityID, const Position& position) noexcept
+        {
+            fmt::print("Archetype entity ID: {} Position: ({}, {})\n", entityID, position.x, position.y);
+        });
+        fmt::print("Archetype entity 12 has Velocity component: {}\n", storage.entityHasComponent<Velocity>(12u));
     }
 
     return 0;